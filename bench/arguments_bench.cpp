@@ -0,0 +1,88 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// The argument list of (f 1 2 ... size).
+Object* MakeArguments(int64_t size) {
+    std::vector<Object*> numbers;
+    for (int64_t i = 1; i <= size; ++i) {
+        numbers.push_back(MakeNumber(i));
+    }
+    return MakeList(ArgumentsView(numbers.data(), numbers.size()));
+}
+
+// (+ 1 2 ... size)
+std::string MakeSum(int64_t size) {
+    std::string source = "(+";
+    for (int64_t i = 1; i <= size; ++i) {
+        source += " " + std::to_string(i);
+    }
+    return source + ")";
+}
+
+// TakeElem with a std::vector in place of Arguments.
+std::vector<Object*> TakeElemIntoVector(Object* args_head) {
+    std::vector<Object*> res;
+    while (args_head != nullptr) {
+        if (!Is<Cell>(args_head)) {
+            res.push_back(args_head);
+            break;
+        }
+        Cell* now_cell = As<Cell>(args_head);
+        if (now_cell->first_ == nullptr && now_cell->second_ == nullptr) {
+            break;
+        }
+        if (now_cell->first_ != nullptr) {
+            res.push_back(now_cell->first_->Calculate());
+        }
+        args_head = now_cell->second_;
+    }
+    return res;
+}
+
+}  // namespace
+
+// TakeElem fills a SmallVector, which holds up to four arguments inline.
+static void BM_TakeElem(benchmark::State& state) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Object* args = MakeArguments(state.range(0));
+    for (auto _ : state) {
+        Arguments elems = TakeElem(args);
+        benchmark::DoNotOptimize(elems.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TakeElem)->Arg(2)->Arg(4)->Arg(16)->Arg(1000)->Arg(100000);
+
+// The same pass into a std::vector, which allocates for every call.
+static void BM_TakeElemIntoVector(benchmark::State& state) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Object* args = MakeArguments(state.range(0));
+    for (auto _ : state) {
+        std::vector<Object*> elems = TakeElemIntoVector(args);
+        benchmark::DoNotOptimize(elems.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TakeElemIntoVector)->Arg(2)->Arg(4)->Arg(16)->Arg(1000)->Arg(100000);
+
+// The whole call through the interpreter, parsed and compiled once.
+static void BM_SumArguments(benchmark::State& state) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(1);
+    std::string source = MakeSum(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(source));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SumArguments)->Arg(4)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr int kCalls = 10000;
+
+// Defines f as a closure over depth frames, made by nested lets, that adds
+// body's variable to its argument, and calls it kCalls times per iteration.
+void CallClosure(benchmark::State& state, const std::string& body) {
+    Interpreter interpreter;
+    std::string closure;
+    for (int64_t i = 1; i <= state.range(0); ++i) {
+        closure += "(let ((v" + std::to_string(i) + " 1)) ";
+    }
+    closure += "(lambda (x) (+ x " + body + "))" + std::string(state.range(0), ')');
+    interpreter.Run("(define f " + closure + ")");
+    interpreter.Run("(define (run n acc) (if (= n 0) acc (run (- n 1) (f acc))))");
+    std::string source = "(run " + std::to_string(kCalls) + " 0)";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(source));
+    }
+    state.SetItemsProcessed(state.iterations() * kCalls);
+}
+
+}  // namespace
+
+// Reads only its own parameter, whatever the depth of its environment.
+static void BM_ClosureCallLocal(benchmark::State& state) {
+    CallClosure(state, "x");
+}
+BENCHMARK(BM_ClosureCallLocal)->ArgName("depth")->Arg(1)->Arg(8)->Arg(64);
+
+// Reads the variable of the innermost let around it.
+static void BM_ClosureCallInner(benchmark::State& state) {
+    CallClosure(state, "v" + std::to_string(state.range(0)));
+}
+BENCHMARK(BM_ClosureCallInner)->ArgName("depth")->Arg(1)->Arg(8)->Arg(64);
+
+// Reads the variable of the outermost let, depth frames out.
+static void BM_ClosureCallOuter(benchmark::State& state) {
+    CallClosure(state, "v1");
+}
+BENCHMARK(BM_ClosureCallOuter)->ArgName("depth")->Arg(1)->Arg(8)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+
+// Runs source, parsed and compiled once, and counts size tests per run.
+void RunChain(benchmark::State& state, const std::string& source) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(1);
+    interpreter.Run("(define xs '(1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16))");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(source));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+std::string Repeat(const std::string& text, int64_t count) {
+    std::string res;
+    for (int64_t i = 0; i < count; ++i) {
+        res += text;
+    }
+    return res;
+}
+
+}  // namespace
+
+// Every test is true, the last one gives the value.
+static void BM_AndChain(benchmark::State& state) {
+    RunChain(state, "(and" + Repeat(" (< 1 2)", state.range(0)) + " 'last)");
+}
+BENCHMARK(BM_AndChain)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Every test is false.
+static void BM_OrChain(benchmark::State& state) {
+    RunChain(state, "(or" + Repeat(" (> 1 2)", state.range(0)) + " 'last)");
+}
+BENCHMARK(BM_OrChain)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Truthiness of a list value, which used to be printed to be tested.
+static void BM_AndListValues(benchmark::State& state) {
+    RunChain(state, "(and" + Repeat(" xs", state.range(0)) + ")");
+}
+BENCHMARK(BM_AndListValues)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Only the else clause is taken.
+static void BM_CondChain(benchmark::State& state) {
+    RunChain(state, "(cond" + Repeat(" ((null? xs) 1)", state.range(0)) + " (else 'last))");
+}
+BENCHMARK(BM_CondChain)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Nested ifs that each take their alternative.
+static void BM_IfChain(benchmark::State& state) {
+    RunChain(state, Repeat("(if (= 1 2) 0 ", state.range(0)) + "'last" +
+                        std::string(state.range(0), ')'));
+}
+BENCHMARK(BM_IfChain)->Arg(10)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
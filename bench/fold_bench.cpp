@@ -0,0 +1,57 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Constant subexpressions in the places the folder reaches: pure calls,
+// closure call arguments, a definition and a lambda body.
+const char* const kSources[] = {
+    "(+ (* 3 4) (- 10 (* 2 2)) (/ 100 (+ 5 5)))",
+    "(f (* 60 60 24) (+ 1 (* 2 3)))",
+    "(define limit (* 1024 (+ 1 (* 2 3))))",
+    "(vector-ref (vector (* 2 2) (+ 1 1)) (- 3 2))",
+};
+
+void RunSources(benchmark::State& state, EvaluationMode mode) {
+    Interpreter interpreter;
+    interpreter.SetEvaluationMode(mode);
+    interpreter.SetCacheCapacity(16);
+    interpreter.SetConstantFolding(state.range(0) != 0);
+    interpreter.Run("(define (f a b) (if (< a b) (- b a) (- a (* b (+ 1 1)))))");
+    for (auto _ : state) {
+        for (const char* source : kSources) {
+            benchmark::DoNotOptimize(interpreter.Run(source));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(kSources));
+}
+
+}  // namespace
+
+static void BM_CachedBytecode(benchmark::State& state) {
+    RunSources(state, EvaluationMode::BYTECODE);
+}
+BENCHMARK(BM_CachedBytecode)->ArgName("fold")->Arg(0)->Arg(1);
+
+static void BM_CachedTreeWalk(benchmark::State& state) {
+    RunSources(state, EvaluationMode::TREE_WALK);
+}
+BENCHMARK(BM_CachedTreeWalk)->ArgName("fold")->Arg(0)->Arg(1);
+
+// The cost of the pass itself, paid once per source with the cache and
+// on every run without it.
+static void BM_UncachedBytecode(benchmark::State& state) {
+    Interpreter interpreter;
+    interpreter.SetConstantFolding(state.range(0) != 0);
+    interpreter.Run("(define (f a b) (if (< a b) (- b a) (- a (* b (+ 1 1)))))");
+    for (auto _ : state) {
+        for (const char* source : kSources) {
+            benchmark::DoNotOptimize(interpreter.Run(source));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(kSources));
+}
+BENCHMARK(BM_UncachedBytecode)->ArgName("fold")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
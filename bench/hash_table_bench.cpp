@@ -0,0 +1,86 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+
+// Lookups per run, spread evenly over the keys.
+constexpr int kLookups = 100;
+
+// Keys 0 ... n-1, each bound to itself, in a hash table and in an association
+// list, and loops that build and search both.
+const char* const kDefinitions[] = {
+    "(define (fill-table t i n) (when (< i n) (hash-table-set! t i i) (fill-table t (+ i 1) n)))",
+    "(define (make-table n) (define t (make-hash-table)) (fill-table t 0 n) t)",
+    "(define (make-alist i n acc) (if (= i n) acc (make-alist (+ i 1) n (cons (cons i i) acc))))",
+    "(define (alist-ref alist key)"
+    "  (cond ((null? alist) #f)"
+    "        ((= (car (car alist)) key) (cdr (car alist)))"
+    "        (else (alist-ref (cdr alist) key))))",
+    "(define (sum-table t key step count acc)"
+    "  (if (= count 0) acc"
+    "      (sum-table t (+ key step) step (- count 1) (+ acc (hash-table-ref t key)))))",
+    "(define (sum-alist alist key step count acc)"
+    "  (if (= count 0) acc"
+    "      (sum-alist alist (+ key step) step (- count 1) (+ acc (alist-ref alist key)))))",
+};
+
+void Define(Interpreter* interpreter, int64_t size) {
+    for (const char* definition : kDefinitions) {
+        interpreter->Run(definition);
+    }
+    interpreter->Run("(define table (make-table " + std::to_string(size) + "))");
+    interpreter->Run("(define alist (make-alist 0 " + std::to_string(size) + " '()))");
+}
+
+void RunLookups(benchmark::State& state, const std::string& sum) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(1);
+    Define(&interpreter, state.range(0));
+    int64_t step = state.range(0) / kLookups > 0 ? state.range(0) / kLookups : 1;
+    int64_t lookups = state.range(0) < kLookups ? state.range(0) : kLookups;
+    std::string source =
+        "(" + sum + " 0 " + std::to_string(step) + " " + std::to_string(lookups) + " 0)";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(source));
+    }
+    state.SetItemsProcessed(state.iterations() * lookups);
+}
+
+void RunInserts(benchmark::State& state, const std::string& make) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(1);
+    Define(&interpreter, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(make));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+static void BM_HashTableLookup(benchmark::State& state) {
+    RunLookups(state, "sum-table table");
+}
+BENCHMARK(BM_HashTableLookup)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+
+static void BM_AlistLookup(benchmark::State& state) {
+    RunLookups(state, "sum-alist alist");
+}
+BENCHMARK(BM_AlistLookup)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+
+// Builds a table of n keys from scratch.
+static void BM_HashTableInsert(benchmark::State& state) {
+    RunInserts(state, "(hash-table-count (make-table " + std::to_string(state.range(0)) + "))");
+}
+BENCHMARK(BM_HashTableInsert)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+
+// Builds an association list of n keys, which are known to be new, from scratch.
+static void BM_AlistInsert(benchmark::State& state) {
+    RunInserts(state, "(car (make-alist 0 " + std::to_string(state.range(0)) + " '()))");
+}
+BENCHMARK(BM_AlistInsert)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,43 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_MakeCell(benchmark::State& state) {
+    Heap heap;
+    HeapScope scope(&heap);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Make<Cell>());
+        if (heap.ShouldCollect()) {
+            heap.Collect({});
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MakeCell);
+
+static void BM_MakeRun(benchmark::State& state) {
+    Heap heap;
+    HeapScope scope(&heap);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MakeRun<Cell>(state.range(0)));
+        if (heap.ShouldCollect()) {
+            heap.Collect({});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MakeRun)->Arg(16)->Arg(1024);
+
+static void BM_BuildList(benchmark::State& state) {
+    Interpreter interpreter;
+    interpreter.Run(
+        "(define build (lambda (n acc) (if (= n 0) acc (build (- n 1) (cons n acc)))))");
+    std::string source = "(car (build " + std::to_string(state.range(0)) + " '()))";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.Run(source));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildList)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
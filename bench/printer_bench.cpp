@@ -0,0 +1,95 @@
+#include "scheme.h"
+
+#include <benchmark/benchmark.h>
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace {
+
+// Drops what is written, so the stream benchmarks time the printer alone.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+Object* ReadOne(const std::string& source) {
+    Tokenizer tokenizer{std::string_view(source)};
+    return Read(&tokenizer);
+}
+
+// (x x ... x) with size elements.
+std::string MakeFlat(int64_t size) {
+    std::string source = "(";
+    for (int64_t i = 0; i < size; ++i) {
+        source += "x ";
+    }
+    source.back() = ')';
+    return source;
+}
+
+// (1 (1 (1 ... ()))) nested depth times.
+std::string MakeNested(int64_t depth) {
+    std::string source;
+    for (int64_t i = 0; i < depth; ++i) {
+        source += "(1 ";
+    }
+    return source + "()" + std::string(depth, ')');
+}
+
+void PrintToString(benchmark::State& state, const std::string& source) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Object* value = ReadOne(source);
+    std::string text;
+    for (auto _ : state) {
+        text.clear();
+        Print(value, &text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void PrintToStream(benchmark::State& state, const std::string& source) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Object* value = ReadOne(source);
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+    for (auto _ : state) {
+        Print(value, &out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+static void BM_PrintFlatList(benchmark::State& state) {
+    PrintToString(state, MakeFlat(state.range(0)));
+}
+BENCHMARK(BM_PrintFlatList)->Arg(1000)->Arg(1000000);
+
+static void BM_PrintFlatListToStream(benchmark::State& state) {
+    PrintToStream(state, MakeFlat(state.range(0)));
+}
+BENCHMARK(BM_PrintFlatListToStream)->Arg(1000)->Arg(1000000);
+
+static void BM_PrintNestedList(benchmark::State& state) {
+    PrintToString(state, MakeNested(state.range(0)));
+}
+BENCHMARK(BM_PrintNestedList)->ArgName("depth")->Arg(1000)->Arg(1000000);
+
+static void BM_PrintNestedListToStream(benchmark::State& state) {
+    PrintToStream(state, MakeNested(state.range(0)));
+}
+BENCHMARK(BM_PrintNestedListToStream)->ArgName("depth")->Arg(1000)->Arg(1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+#include "char_scan.h"
+#include "tokenizer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+// A program-like mix of brackets, long and short names, numbers and indentation.
+std::string MakeSource(size_t size) {
+    std::string text;
+    for (int i = 0; text.size() < size; ++i) {
+        text += "(define (accumulate-values-" + std::to_string(i) + " lst acc)\n";
+        text += "    (if (null? lst) acc\n";
+        text += "        (accumulate-values (cdr lst) (+ acc (* " + std::to_string(i * 7919) +
+                " (car lst))))))\n";
+    }
+    return text;
+}
+
+size_t CountTokens(Tokenizer* tokenizer) {
+    size_t count = 0;
+    while (!tokenizer->IsEnd()) {
+        ++count;
+        tokenizer->Next();
+    }
+    return count;
+}
+
+using Scan = const char* (*)(const char* begin, const char* end);
+
+// Times scan over a run of size characters of the class, so the vector and
+// the scalar scans run on the same input.
+void RunScan(benchmark::State& state, Scan scan, char inside) {
+    std::string text(state.range(0), inside);
+    text += ')';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scan(text.data(), text.data() + text.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+static void BM_TokenizeBuffer(benchmark::State& state) {
+    std::string source = MakeSource(1 << 20);
+    for (auto _ : state) {
+        Tokenizer tokenizer{std::string_view(source)};
+        benchmark::DoNotOptimize(CountTokens(&tokenizer));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_TokenizeBuffer);
+
+static void BM_TokenizeStream(benchmark::State& state) {
+    std::string source = MakeSource(1 << 20);
+    for (auto _ : state) {
+        std::istringstream in(source);
+        Tokenizer tokenizer{&in};
+        benchmark::DoNotOptimize(CountTokens(&tokenizer));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_TokenizeStream);
+
+static void BM_TokenizeWhitespace(benchmark::State& state) {
+    std::string source = "(a" + std::string(1 << 20, ' ') + "b)";
+    for (auto _ : state) {
+        Tokenizer tokenizer{std::string_view(source)};
+        benchmark::DoNotOptimize(CountTokens(&tokenizer));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_TokenizeWhitespace);
+
+static void BM_SkipSpaces(benchmark::State& state) {
+    RunScan(state, SkipSpaces, ' ');
+}
+BENCHMARK(BM_SkipSpaces)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+static void BM_SkipSpacesScalar(benchmark::State& state) {
+    RunScan(state, SkipSpacesScalar, ' ');
+}
+BENCHMARK(BM_SkipSpacesScalar)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+static void BM_SkipDigits(benchmark::State& state) {
+    RunScan(state, SkipDigits, '7');
+}
+BENCHMARK(BM_SkipDigits)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+static void BM_SkipDigitsScalar(benchmark::State& state) {
+    RunScan(state, SkipDigitsScalar, '7');
+}
+BENCHMARK(BM_SkipDigitsScalar)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+static void BM_SkipSymbolChars(benchmark::State& state) {
+    RunScan(state, SkipSymbolChars, 'a');
+}
+BENCHMARK(BM_SkipSymbolChars)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+static void BM_SkipSymbolCharsScalar(benchmark::State& state) {
+    RunScan(state, SkipSymbolCharsScalar, 'a');
+}
+BENCHMARK(BM_SkipSymbolCharsScalar)->Arg(16)->Arg(256)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,26 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+void* Arena::Allocate(size_t size, size_t align) {
+    auto aligned = [&] {
+        uintptr_t address = reinterpret_cast<uintptr_t>(current_);
+        return reinterpret_cast<char*>((address + align - 1) & ~(uintptr_t(align) - 1));
+    };
+    char* result = aligned();
+    if (current_ == nullptr || result + size > end_) {
+        AddChunk(size + align);
+        result = aligned();
+    }
+    current_ = result + size;
+    bytes_allocated_ += size;
+    return result;
+}
+
+void Arena::AddChunk(size_t min_size) {
+    size_t size = std::max(chunk_size_, min_size);
+    chunks_.emplace_back(new char[size]);
+    current_ = chunks_.back().get();
+    end_ = current_ + size;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for short-lived objects. Memory is only given back all at
+// once by the destructor, so nothing allocated here may outlive the arena.
+class Arena {
+public:
+    explicit Arena(size_t chunk_size = 64 * 1024) : chunk_size_(chunk_size) {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t align);
+
+    size_t BytesAllocated() const {
+        return bytes_allocated_;
+    }
+
+    size_t ChunkCount() const {
+        return chunks_.size();
+    }
+
+private:
+    void AddChunk(size_t min_size);
+
+    size_t chunk_size_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    size_t bytes_allocated_ = 0;
+};
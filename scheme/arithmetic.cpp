@@ -0,0 +1,278 @@
+#include "arithmetic.h"
+#include "reduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+NumberKind Contagion(Number* first, Number* second) {
+    return std::max(first->GetKind(), second->GetKind());
+}
+
+BigInt Gcd(BigInt first, BigInt second) {
+    while (!second.IsZero()) {
+        first = first % second;
+        std::swap(first, second);
+    }
+    return first.IsNegative() ? -first : first;
+}
+
+// Runs shorter than this are folded one number at a time.
+constexpr size_t kMinRun = 4;
+// Runs are reduced in chunks of at most this many numbers.
+constexpr size_t kMaxRun = 64;
+
+// A sum of up to kMaxRun fixnums below this in magnitude cannot overflow.
+constexpr int64_t kSummableFixnum = int64_t(1) << 32;
+
+template <class Accept>
+size_t GatherFixnums(ArgumentsView numbers, size_t begin, int64_t* out, Accept accept) {
+    size_t count = 0;
+    for (size_t i = begin; i < numbers.size() && count < kMaxRun; ++i, ++count) {
+        Number* number = As<Number>(numbers[i]);
+        if (!number->IsSmall() || !accept(number->GetValue())) {
+            break;
+        }
+        out[count] = number->GetValue();
+    }
+    return count;
+}
+
+size_t GatherReals(ArgumentsView numbers, size_t begin, double* out) {
+    size_t count = 0;
+    for (size_t i = begin; i < numbers.size() && count < kMaxRun; ++i, ++count) {
+        Number* number = As<Number>(numbers[i]);
+        if (number->GetKind() != NumberKind::REAL) {
+            break;
+        }
+        out[count] = number->GetReal();
+    }
+    return count;
+}
+
+bool AnyFixnum(int64_t) {
+    return true;
+}
+
+// Folds numbers from begin with combine. Runs of fixnums and runs of reals are
+// folded into res by fold_fixnums and fold_reals, which take res and the run.
+template <class Combine, class FoldFixnums, class FoldReals, class Accept>
+Number* Reduce(Number* res, ArgumentsView numbers, size_t begin, Combine combine,
+               FoldFixnums fold_fixnums, FoldReals fold_reals, Accept accept) {
+    int64_t fixnums[kMaxRun];
+    double reals[kMaxRun];
+    size_t i = begin;
+    while (i < numbers.size()) {
+        size_t count = GatherFixnums(numbers, i, fixnums, accept);
+        if (count >= kMinRun) {
+            res = fold_fixnums(res, fixnums, count);
+            i += count;
+            continue;
+        }
+        count = GatherReals(numbers, i, reals);
+        if (count >= kMinRun) {
+            res = fold_reals(res, reals, count);
+            i += count;
+            continue;
+        }
+        res = combine(res, As<Number>(numbers[i]));
+        ++i;
+    }
+    return res;
+}
+
+// Keeps the number that wins every comparison: second replaces first if
+// prefer_second(Compare(first, second)).
+template <class Prefer, class ReduceFixnums, class ReduceReals>
+Number* Extremum(ArgumentsView numbers, Prefer prefer_second, ReduceFixnums reduce_fixnums,
+                 ReduceReals reduce_reals) {
+    bool inexact = false;
+    for (Object* object : numbers) {
+        Number* number = As<Number>(object);
+        if (IsUnordered(number, number)) {
+            return number;
+        }
+        inexact = inexact || number->GetKind() == NumberKind::REAL;
+    }
+    auto combine = [prefer_second](Number* first, Number* second) {
+        return prefer_second(Compare(first, second)) ? second : first;
+    };
+    auto fold_fixnums = [combine, reduce_fixnums](Number* res, const int64_t* values,
+                                                  size_t size) {
+        return combine(res, MakeNumber(reduce_fixnums(values, size)));
+    };
+    auto fold_reals = [combine, reduce_reals](Number* res, const double* values, size_t size) {
+        return combine(res, MakeReal(reduce_reals(values, size)));
+    };
+    Number* res =
+        Reduce(As<Number>(numbers[0]), numbers, 1, combine, fold_fixnums, fold_reals, AnyFixnum);
+    return inexact ? ToInexact(res) : res;
+}
+
+}  // namespace
+
+Number* MakeRational(BigInt numerator, BigInt denominator) {
+    if (denominator.IsZero()) {
+        throw RuntimeError("");
+    }
+    if (denominator.IsNegative()) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    BigInt divisor = Gcd(numerator, denominator);
+    numerator = numerator / divisor;
+    denominator = denominator / divisor;
+    if (denominator == BigInt(1)) {
+        return MakeNumber(std::move(numerator));
+    }
+    return Make<Number>(std::move(numerator), std::move(denominator));
+}
+
+Number* Add(Number* first, Number* second) {
+    int64_t res;
+    if (first->IsSmall() && second->IsSmall() &&
+        !__builtin_add_overflow(first->GetValue(), second->GetValue(), &res)) {
+        return MakeNumber(res);
+    }
+    switch (Contagion(first, second)) {
+        case NumberKind::REAL:
+            return MakeReal(first->ToDouble() + second->ToDouble());
+        case NumberKind::RATIONAL:
+            return MakeRational(first->GetNumerator() * second->GetDenominator() +
+                                    second->GetNumerator() * first->GetDenominator(),
+                                first->GetDenominator() * second->GetDenominator());
+        default:
+            return MakeNumber(first->ToBig() + second->ToBig());
+    }
+}
+
+Number* Subtract(Number* first, Number* second) {
+    int64_t res;
+    if (first->IsSmall() && second->IsSmall() &&
+        !__builtin_sub_overflow(first->GetValue(), second->GetValue(), &res)) {
+        return MakeNumber(res);
+    }
+    switch (Contagion(first, second)) {
+        case NumberKind::REAL:
+            return MakeReal(first->ToDouble() - second->ToDouble());
+        case NumberKind::RATIONAL:
+            return MakeRational(first->GetNumerator() * second->GetDenominator() -
+                                    second->GetNumerator() * first->GetDenominator(),
+                                first->GetDenominator() * second->GetDenominator());
+        default:
+            return MakeNumber(first->ToBig() - second->ToBig());
+    }
+}
+
+Number* Multiply(Number* first, Number* second) {
+    int64_t res;
+    if (first->IsSmall() && second->IsSmall() &&
+        !__builtin_mul_overflow(first->GetValue(), second->GetValue(), &res)) {
+        return MakeNumber(res);
+    }
+    switch (Contagion(first, second)) {
+        case NumberKind::REAL:
+            return MakeReal(first->ToDouble() * second->ToDouble());
+        case NumberKind::RATIONAL:
+            return MakeRational(first->GetNumerator() * second->GetNumerator(),
+                                first->GetDenominator() * second->GetDenominator());
+        default:
+            return MakeNumber(first->ToBig() * second->ToBig());
+    }
+}
+
+Number* Divide(Number* first, Number* second) {
+    if (Contagion(first, second) == NumberKind::REAL) {
+        return MakeReal(first->ToDouble() / second->ToDouble());
+    }
+    if (first->IsSmall() && second->IsSmall() && second->GetValue() != 0 &&
+        !(first->GetValue() == INT64_MIN && second->GetValue() == -1) &&
+        first->GetValue() % second->GetValue() == 0) {
+        return MakeNumber(first->GetValue() / second->GetValue());
+    }
+    return MakeRational(first->GetNumerator() * second->GetDenominator(),
+                        first->GetDenominator() * second->GetNumerator());
+}
+
+Number* Abs(Number* number) {
+    switch (number->GetKind()) {
+        case NumberKind::REAL:
+            return MakeReal(std::fabs(number->GetReal()));
+        case NumberKind::RATIONAL: {
+            BigInt numerator = number->GetNumerator();
+            if (!numerator.IsNegative()) {
+                return number;
+            }
+            return Make<Number>(-numerator, number->GetDenominator());
+        }
+        default:
+            break;
+    }
+    if (number->IsSmall() && number->GetValue() != INT64_MIN) {
+        return MakeNumber(number->GetValue() < 0 ? -number->GetValue() : number->GetValue());
+    }
+    BigInt big = number->ToBig();
+    return MakeNumber(big.IsNegative() ? -big : big);
+}
+
+Number* ToInexact(Number* number) {
+    if (number->GetKind() == NumberKind::REAL) {
+        return number;
+    }
+    return MakeReal(number->ToDouble());
+}
+
+int Compare(Number* first, Number* second) {
+    if (first->IsSmall() && second->IsSmall()) {
+        return (first->GetValue() > second->GetValue()) - (first->GetValue() < second->GetValue());
+    }
+    switch (Contagion(first, second)) {
+        case NumberKind::REAL: {
+            double first_value = first->ToDouble();
+            double second_value = second->ToDouble();
+            return (first_value > second_value) - (first_value < second_value);
+        }
+        case NumberKind::RATIONAL:
+            return Compare(first->GetNumerator() * second->GetDenominator(),
+                           second->GetNumerator() * first->GetDenominator());
+        default:
+            return Compare(first->ToBig(), second->ToBig());
+    }
+}
+
+bool IsUnordered(Number* first, Number* second) {
+    auto is_nan = [](Number* number) {
+        return number->GetKind() == NumberKind::REAL && std::isnan(number->GetReal());
+    };
+    return is_nan(first) || is_nan(second);
+}
+
+Number* Sum(ArgumentsView numbers) {
+    // Reals are added to the running sum one by one, as a left fold would. So
+    // are fixnums once the sum is inexact: their exact total may round
+    // differently.
+    auto fold_fixnums = [](Number* res, const int64_t* values, size_t size) {
+        if (res->GetKind() != NumberKind::REAL) {
+            return Add(res, MakeNumber(SumFixnums(values, size)));
+        }
+        double reals[kMaxRun];
+        std::copy(values, values + size, reals);
+        return MakeReal(SumReals(res->GetReal(), reals, size));
+    };
+    auto fold_reals = [](Number* res, const double* values, size_t size) {
+        return MakeReal(SumReals(res->ToDouble(), values, size));
+    };
+    return Reduce(MakeNumber(0), numbers, 0, Add, fold_fixnums, fold_reals, [](int64_t value) {
+        return value > -kSummableFixnum && value < kSummableFixnum;
+    });
+}
+
+Number* Max(ArgumentsView numbers) {
+    return Extremum(numbers, [](int order) { return order < 0; }, MaxFixnums, MaxReals);
+}
+
+Number* Min(ArgumentsView numbers) {
+    return Extremum(numbers, [](int order) { return order > 0; }, MinFixnums, MinReals);
+}
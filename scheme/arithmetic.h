@@ -0,0 +1,37 @@
+#pragma once
+
+#include "object.h"
+
+// Arithmetic on the numeric tower. An operation on two numbers is carried
+// out in the later of their two NumberKinds, so any real makes the result
+// real. Integers are handled on fixnums with overflow checks while operands
+// and result fit in int64_t and redone on BigInts otherwise. Results come
+// from MakeNumber and MakeRational, so they are never bigger than needed.
+Number* Add(Number* first, Number* second);
+Number* Subtract(Number* first, Number* second);
+Number* Multiply(Number* first, Number* second);
+
+// Exact unless a real is involved: (/ 7 2) is 7/2. Throws RuntimeError on
+// exact division by zero.
+Number* Divide(Number* first, Number* second);
+
+Number* Abs(Number* number);
+
+// The same number as a real.
+Number* ToInexact(Number* number);
+
+// Negative, zero or positive as first is less than, equal to or greater than
+// second. Meaningless if IsUnordered(first, second).
+int Compare(Number* first, Number* second);
+
+// True if either number is a NaN, which is neither less than, equal to nor
+// greater than any number, itself included.
+bool IsUnordered(Number* first, Number* second);
+
+// Variadic forms over numbers. Long runs of fixnums or reals are gathered into
+// plain arrays and reduced by the kernels in reduce.h. Max and Min return a
+// real if any argument is real, and a NaN if any argument is one. numbers
+// must not be empty for Max and Min.
+Number* Sum(ArgumentsView numbers);
+Number* Max(ArgumentsView numbers);
+Number* Min(ArgumentsView numbers);
@@ -0,0 +1,350 @@
+#include "bigint.h"
+#include "char_scan.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+using Limbs = std::vector<uint32_t>;
+
+constexpr uint32_t kDecimalChunk = 1000000000;
+constexpr size_t kDecimalChunkDigits = 9;
+
+void Trim(Limbs* limbs) {
+    while (!limbs->empty() && limbs->back() == 0) {
+        limbs->pop_back();
+    }
+}
+
+int CompareLimbs(const Limbs& first, const Limbs& second) {
+    if (first.size() != second.size()) {
+        return first.size() < second.size() ? -1 : 1;
+    }
+    for (size_t i = first.size(); i-- > 0;) {
+        if (first[i] != second[i]) {
+            return first[i] < second[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+Limbs AddLimbs(const Limbs& first, const Limbs& second) {
+    const Limbs& longer = first.size() >= second.size() ? first : second;
+    const Limbs& shorter = first.size() >= second.size() ? second : first;
+    Limbs res(longer.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+        uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0);
+        res[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    res[longer.size()] = carry;
+    Trim(&res);
+    return res;
+}
+
+// first must not be less than second.
+Limbs SubtractLimbs(const Limbs& first, const Limbs& second) {
+    Limbs res(first.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        int64_t diff = static_cast<int64_t>(first[i]) - (i < second.size() ? second[i] : 0) - borrow;
+        borrow = diff < 0;
+        res[i] = static_cast<uint32_t>(diff);
+    }
+    Trim(&res);
+    return res;
+}
+
+// Adds addend shifted left by shift limbs to *sum, which has room for the result.
+void AddShifted(Limbs* sum, const Limbs& addend, size_t shift) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < addend.size(); ++i) {
+        uint64_t now = carry + (*sum)[i + shift] + addend[i];
+        (*sum)[i + shift] = static_cast<uint32_t>(now);
+        carry = now >> 32;
+    }
+    for (i += shift; carry != 0; ++i) {
+        uint64_t now = carry + (*sum)[i];
+        (*sum)[i] = static_cast<uint32_t>(now);
+        carry = now >> 32;
+    }
+}
+
+Limbs Slice(const Limbs& limbs, size_t begin, size_t end) {
+    begin = std::min(begin, limbs.size());
+    end = std::min(end, limbs.size());
+    Limbs res(limbs.begin() + begin, limbs.begin() + end);
+    Trim(&res);
+    return res;
+}
+
+Limbs MultiplySchoolbook(const Limbs& first, const Limbs& second) {
+    if (first.empty() || second.empty()) {
+        return {};
+    }
+    Limbs res(first.size() + second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < second.size(); ++j) {
+            uint64_t now = static_cast<uint64_t>(first[i]) * second[j] + res[i + j] + carry;
+            res[i + j] = static_cast<uint32_t>(now);
+            carry = now >> 32;
+        }
+        res[i + second.size()] = carry;
+    }
+    Trim(&res);
+    return res;
+}
+
+Limbs MultiplyLimbs(const Limbs& first, const Limbs& second) {
+    const Limbs& longer = first.size() >= second.size() ? first : second;
+    const Limbs& shorter = first.size() >= second.size() ? second : first;
+    if (shorter.size() < BigInt::kKaratsubaThreshold) {
+        return MultiplySchoolbook(longer, shorter);
+    }
+    size_t half = longer.size() / 2;
+    Limbs res(longer.size() + shorter.size() + 1);
+    Limbs low = Slice(longer, 0, half);
+    Limbs high = Slice(longer, half, longer.size());
+    if (shorter.size() <= half) {
+        // Too lopsided to split both: multiply each half of the longer one.
+        AddShifted(&res, MultiplyLimbs(low, shorter), 0);
+        AddShifted(&res, MultiplyLimbs(high, shorter), half);
+    } else {
+        Limbs other_low = Slice(shorter, 0, half);
+        Limbs other_high = Slice(shorter, half, shorter.size());
+        Limbs low_product = MultiplyLimbs(low, other_low);
+        Limbs high_product = MultiplyLimbs(high, other_high);
+        Limbs middle = MultiplyLimbs(AddLimbs(low, high), AddLimbs(other_low, other_high));
+        middle = SubtractLimbs(SubtractLimbs(middle, low_product), high_product);
+        AddShifted(&res, low_product, 0);
+        AddShifted(&res, middle, half);
+        AddShifted(&res, high_product, 2 * half);
+    }
+    Trim(&res);
+    return res;
+}
+
+// Divides *limbs in place by a single limb and returns the remainder.
+uint32_t DivideBySmall(Limbs* limbs, uint32_t divisor) {
+    uint64_t rem = 0;
+    for (size_t i = limbs->size(); i-- > 0;) {
+        uint64_t now = (rem << 32) | (*limbs)[i];
+        (*limbs)[i] = now / divisor;
+        rem = now % divisor;
+    }
+    Trim(limbs);
+    return rem;
+}
+
+Limbs ShiftLeft(const Limbs& limbs, int shift, size_t size) {
+    Limbs res(size);
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        res[i] |= limbs[i] << shift;
+        if (shift != 0) {
+            res[i + 1] = limbs[i] >> (32 - shift);
+        }
+    }
+    return res;
+}
+
+// Knuth's Algorithm D. divisor must not be empty. Stores the remainder in
+// *remainder unless it is null.
+Limbs DivideLimbs(const Limbs& dividend, const Limbs& divisor, Limbs* remainder = nullptr) {
+    if (CompareLimbs(dividend, divisor) < 0) {
+        if (remainder != nullptr) {
+            *remainder = dividend;
+        }
+        return {};
+    }
+    if (divisor.size() == 1) {
+        Limbs res = dividend;
+        uint32_t rem = DivideBySmall(&res, divisor[0]);
+        if (remainder != nullptr) {
+            *remainder = {rem};
+            Trim(remainder);
+        }
+        return res;
+    }
+    // Normalize so that the top limb of the divisor has its high bit set.
+    int shift = __builtin_clz(divisor.back());
+    Limbs u = ShiftLeft(dividend, shift, dividend.size() + 1);
+    Limbs v = ShiftLeft(divisor, shift, divisor.size() + 1);
+    size_t n = divisor.size();
+    size_t m = dividend.size() - n;
+    Limbs res(m + 1);
+    for (size_t j = m + 1; j-- > 0;) {
+        uint64_t numerator = (static_cast<uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+        uint64_t qhat = numerator / v[n - 1];
+        uint64_t rhat = numerator % v[n - 1];
+        while (qhat > UINT32_MAX || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            --qhat;
+            rhat += v[n - 1];
+            if (rhat > UINT32_MAX) {
+                break;
+            }
+        }
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t product = qhat * v[i] + carry;
+            carry = product >> 32;
+            int64_t diff = static_cast<int64_t>(u[i + j]) - static_cast<uint32_t>(product) - borrow;
+            u[i + j] = static_cast<uint32_t>(diff);
+            borrow = diff < 0;
+        }
+        int64_t diff = static_cast<int64_t>(u[j + n]) - static_cast<int64_t>(carry) - borrow;
+        u[j + n] = static_cast<uint32_t>(diff);
+        if (diff < 0) {
+            // qhat was one too large: add the divisor back.
+            --qhat;
+            carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t now = carry + u[i + j] + v[i];
+                u[i + j] = static_cast<uint32_t>(now);
+                carry = now >> 32;
+            }
+            u[j + n] += carry;
+        }
+        res[j] = qhat;
+    }
+    if (remainder != nullptr) {
+        // Undo the normalization on what is left of the dividend.
+        remainder->assign(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            (*remainder)[i] = u[i] >> shift;
+            if (shift != 0) {
+                (*remainder)[i] |= u[i + 1] << (32 - shift);
+            }
+        }
+        Trim(remainder);
+    }
+    Trim(&res);
+    return res;
+}
+
+}  // namespace
+
+BigInt::BigInt(int64_t value) : negative_(value < 0) {
+    uint64_t magnitude = negative_ ? -static_cast<uint64_t>(value) : value;
+    limbs_ = {static_cast<uint32_t>(magnitude), static_cast<uint32_t>(magnitude >> 32)};
+    Trim(&limbs_);
+}
+
+BigInt::BigInt(bool negative, std::vector<uint32_t> limbs) : limbs_(std::move(limbs)) {
+    Trim(&limbs_);
+    negative_ = negative && !limbs_.empty();
+}
+
+BigInt BigInt::FromDecimal(std::string_view digits, bool negative) {
+    Limbs limbs;
+    size_t chunk = digits.size() % kDecimalChunkDigits;
+    if (chunk == 0) {
+        chunk = kDecimalChunkDigits;
+    }
+    for (size_t i = 0; i < digits.size(); i += chunk, chunk = kDecimalChunkDigits) {
+        uint64_t carry = ParseDigits(digits.substr(i, chunk));
+        uint64_t scale = 1;
+        for (size_t j = 0; j < chunk; ++j) {
+            scale *= 10;
+        }
+        for (uint32_t& limb : limbs) {
+            uint64_t now = limb * scale + carry;
+            limb = static_cast<uint32_t>(now);
+            carry = now >> 32;
+        }
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+    }
+    return BigInt(negative, std::move(limbs));
+}
+
+bool BigInt::FitsInt64() const {
+    if (limbs_.size() <= 1) {
+        return true;
+    }
+    if (limbs_.size() > 2) {
+        return false;
+    }
+    uint64_t magnitude = (static_cast<uint64_t>(limbs_[1]) << 32) | limbs_[0];
+    return magnitude <= static_cast<uint64_t>(INT64_MAX) + negative_;
+}
+
+int64_t BigInt::ToInt64() const {
+    uint64_t magnitude = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+        magnitude = (magnitude << 32) | limbs_[i];
+    }
+    return static_cast<int64_t>(negative_ ? -magnitude : magnitude);
+}
+
+std::string BigInt::ToString() const {
+    if (IsZero()) {
+        return "0";
+    }
+    Limbs rest = limbs_;
+    std::vector<uint32_t> chunks;
+    while (!rest.empty()) {
+        chunks.push_back(DivideBySmall(&rest, kDecimalChunk));
+    }
+    std::string res = negative_ ? "-" : "";
+    res += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        res.append(kDecimalChunkDigits - chunk.size(), '0');
+        res += chunk;
+    }
+    return res;
+}
+
+double BigInt::ToDouble() const {
+    double res = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+        res = res * 4294967296.0 + limbs_[i];
+    }
+    return negative_ ? -res : res;
+}
+
+BigInt BigInt::operator-() const {
+    return BigInt(!negative_, limbs_);
+}
+
+BigInt operator+(const BigInt& first, const BigInt& second) {
+    if (first.negative_ == second.negative_) {
+        return BigInt(first.negative_, AddLimbs(first.limbs_, second.limbs_));
+    }
+    if (CompareLimbs(first.limbs_, second.limbs_) >= 0) {
+        return BigInt(first.negative_, SubtractLimbs(first.limbs_, second.limbs_));
+    }
+    return BigInt(second.negative_, SubtractLimbs(second.limbs_, first.limbs_));
+}
+
+BigInt operator-(const BigInt& first, const BigInt& second) {
+    return first + -second;
+}
+
+BigInt operator*(const BigInt& first, const BigInt& second) {
+    return BigInt(first.negative_ != second.negative_, MultiplyLimbs(first.limbs_, second.limbs_));
+}
+
+BigInt operator/(const BigInt& first, const BigInt& second) {
+    return BigInt(first.negative_ != second.negative_, DivideLimbs(first.limbs_, second.limbs_));
+}
+
+int Compare(const BigInt& first, const BigInt& second) {
+    if (first.negative_ != second.negative_) {
+        return first.negative_ ? -1 : 1;
+    }
+    int magnitude = CompareLimbs(first.limbs_, second.limbs_);
+    return first.negative_ ? -magnitude : magnitude;
+}
+
+BigInt operator%(const BigInt& first, const BigInt& second) {
+    Limbs remainder;
+    DivideLimbs(first.limbs_, second.limbs_, &remainder);
+    return BigInt(first.negative_, std::move(remainder));
+}
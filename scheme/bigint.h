@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Arbitrary-precision integer: a sign and a magnitude stored as little-endian
+// 32-bit limbs without leading zero limbs. Zero has no limbs and is never negative.
+class BigInt {
+public:
+    BigInt() = default;
+
+    explicit BigInt(int64_t value);
+
+    // Parses a run of decimal digits, nine at a time.
+    static BigInt FromDecimal(std::string_view digits, bool negative);
+
+    bool IsZero() const {
+        return limbs_.empty();
+    }
+
+    bool IsNegative() const {
+        return negative_;
+    }
+
+    bool FitsInt64() const;
+
+    // Only meaningful if FitsInt64().
+    int64_t ToInt64() const;
+
+    std::string ToString() const;
+
+    // Nearest double, or an infinity if the value is out of range.
+    double ToDouble() const;
+
+    BigInt operator-() const;
+
+    friend BigInt operator+(const BigInt& first, const BigInt& second);
+    friend BigInt operator-(const BigInt& first, const BigInt& second);
+
+    // Karatsuba for large operands, schoolbook below kKaratsubaThreshold limbs.
+    friend BigInt operator*(const BigInt& first, const BigInt& second);
+
+    // Truncates toward zero. The divisor must not be zero.
+    friend BigInt operator/(const BigInt& first, const BigInt& second);
+
+    // Remainder of operator/, with the sign of first.
+    friend BigInt operator%(const BigInt& first, const BigInt& second);
+
+    // Negative, zero or positive as first is less than, equal to or greater than second.
+    friend int Compare(const BigInt& first, const BigInt& second);
+
+    bool operator==(const BigInt& other) const {
+        return negative_ == other.negative_ && limbs_ == other.limbs_;
+    }
+
+    static constexpr size_t kKaratsubaThreshold = 32;
+
+private:
+    BigInt(bool negative, std::vector<uint32_t> limbs);
+
+    bool negative_ = false;
+    std::vector<uint32_t> limbs_;
+};
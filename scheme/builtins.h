@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+// Names of the builtin functions. The symbol table interns them right after
+// the fixed symbols, in this order, so builtin i has symbol id
+// kFirstBuiltinSymbol + i. FindBuiltin checks at compile time that its
+// handlers are listed under the same names in the same order.
+constexpr std::string_view kBuiltinNames[] = {
+    "'",
+    "quote",
+    "number?",
+    "=",
+    ">",
+    "<",
+    ">=",
+    "<=",
+    "+",
+    "-",
+    "*",
+    "/",
+    "max",
+    "min",
+    "abs",
+    "boolean?",
+    "not",
+    "and",
+    "or",
+    "null?",
+    "list",
+    "list-ref",
+    "list-tail",
+    "car",
+    "cdr",
+    "cons",
+    "pair?",
+    "list?",
+    "vector?",
+    "vector",
+    "make-vector",
+    "vector-length",
+    "vector-ref",
+    "vector-set!",
+    "vector-fill!",
+    "bytevector?",
+    "bytevector",
+    "make-bytevector",
+    "bytevector-length",
+    "bytevector-u8-ref",
+    "bytevector-u8-set!",
+    "make-hash-table",
+    "hash-table-ref",
+    "hash-table-set!",
+    "hash-table-delete!",
+    "hash-table-count",
+    "lambda",
+    "let",
+    "define",
+    "set!",
+    "if",
+    "cond",
+    "when",
+    "unless",
+};
+
+constexpr size_t kBuiltinCount = std::size(kBuiltinNames);
+
+constexpr size_t MaxBuiltinNameLength() {
+    size_t length = 0;
+    for (std::string_view name : kBuiltinNames) {
+        length = name.size() > length ? name.size() : length;
+    }
+    return length;
+}
+
+constexpr uint32_t HashBuiltinName(std::string_view name, uint32_t seed) {
+    uint32_t hash = seed;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// Perfect hash of the builtin names: the seed is searched at compile time so
+// that no two names share a slot.
+struct BuiltinHashTable {
+    static constexpr size_t kSlots = 512;
+    static constexpr uint8_t kEmpty = 0xff;
+
+    uint32_t seed = 0;
+    std::array<uint8_t, kSlots> slots{};
+};
+
+constexpr BuiltinHashTable MakeBuiltinHashTable() {
+    for (uint32_t seed = 2166136261u;; ++seed) {
+        BuiltinHashTable table;
+        table.seed = seed;
+        for (size_t i = 0; i < BuiltinHashTable::kSlots; ++i) {
+            table.slots[i] = BuiltinHashTable::kEmpty;
+        }
+        bool collision = false;
+        for (size_t i = 0; i < kBuiltinCount && !collision; ++i) {
+            size_t hash = HashBuiltinName(kBuiltinNames[i], seed) % BuiltinHashTable::kSlots;
+            uint8_t& slot = table.slots[hash];
+            collision = slot != BuiltinHashTable::kEmpty;
+            slot = i;
+        }
+        if (!collision) {
+            return table;
+        }
+    }
+}
+
+constexpr BuiltinHashTable kBuiltinHashTable = MakeBuiltinHashTable();
+
+// Index of the builtin called name, or kBuiltinCount if there is none.
+// Costs one hash and one comparison.
+constexpr size_t FindBuiltinName(std::string_view name) {
+    if (name.size() > MaxBuiltinNameLength()) {
+        return kBuiltinCount;
+    }
+    uint8_t index = kBuiltinHashTable.slots[HashBuiltinName(name, kBuiltinHashTable.seed) %
+                                            BuiltinHashTable::kSlots];
+    if (index == BuiltinHashTable::kEmpty || kBuiltinNames[index] != name) {
+        return kBuiltinCount;
+    }
+    return index;
+}
+
+static_assert(FindBuiltinName("list-tail") == 22);
+static_assert(FindBuiltinName("call/cc") == kBuiltinCount);
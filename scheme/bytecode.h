@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Object;
+class StrictFunction;
+struct GlobalVariable;
+
+enum class OpCode : uint8_t {
+    PUSH,                  // push constants[a]
+    POP,                   // drop the top
+    LOAD_LOCAL,            // push slot b of the frame a levels out
+    STORE_LOCAL,           // set slot b of the frame a levels out to the top, keeping it
+    LOAD_GLOBAL,           // push the value of globals[a]
+    STORE_GLOBAL,          // set globals[a], which has to be defined, to the top, keeping it
+    DEFINE_GLOBAL,         // set globals[a] to the top, keeping it
+    CLOSURE,               // push a closure of the Lambda constants[a] over the current frame
+    APPLY,                 // replace a closure and the b arguments above it with its result
+    TAIL_APPLY,            // APPLY whose result is the result of the current code, which it replaces
+    CALL,                  // replace the top b values with functions[a] applied to them
+    CALL1,                 // CALL with b == 1, 2 or 3, through the fixed-arity entry points
+    CALL2,
+    CALL3,
+    JUMP,                  // jump to a
+    JUMP_IF_FALSE,         // pop the top and jump to a if it is #f
+    JUMP_IF_TRUE,          // pop the top and jump to a if it is anything but #f
+    JUMP_IF_FALSE_OR_POP,  // jump to a if the top is #f, pop it otherwise
+    JUMP_IF_TRUE_OR_POP,   // jump to a if the top is anything but #f, pop it otherwise
+    FAIL,                  // raise RuntimeError
+    RETURN,                // finish with the top of the stack as the result
+};
+
+struct Instruction {
+    OpCode op;
+    uint32_t a = 0;
+    uint32_t b = 0;
+};
+
+// Bytecode of one top-level expression or lambda body for the stack machine in vm.h.
+struct Code {
+    std::vector<Instruction> instructions;
+    std::vector<Object*> constants;
+    std::vector<StrictFunction*> functions;
+    std::vector<GlobalVariable*> globals;
+    size_t max_stack = 0;
+};
@@ -0,0 +1,156 @@
+#include "char_scan.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+template <class Predicate>
+const char* ScalarSkip(const char* begin, const char* end, Predicate predicate) {
+    while (begin != end && predicate(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+#if defined(__AVX2__)
+
+using Vector = __m256i;
+using Mask = uint32_t;
+constexpr size_t kWidth = 32;
+
+Vector Load(const char* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+Vector Equal(Vector v, char c) {
+    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+}
+
+// Signed compare: bytes outside of ASCII are negative and never in a range.
+Vector InRange(Vector v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+Vector Or(Vector a, Vector b) {
+    return _mm256_or_si256(a, b);
+}
+
+Mask ToMask(Vector v) {
+    return _mm256_movemask_epi8(v);
+}
+
+#elif defined(__SSE2__)
+
+using Vector = __m128i;
+using Mask = uint32_t;
+constexpr size_t kWidth = 16;
+
+Vector Load(const char* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+Vector Equal(Vector v, char c) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+// Signed compare: bytes outside of ASCII are negative and never in a range.
+Vector InRange(Vector v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+Vector Or(Vector a, Vector b) {
+    return _mm_or_si128(a, b);
+}
+
+Mask ToMask(Vector v) {
+    return _mm_movemask_epi8(v);
+}
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+constexpr Mask kFullMask = kWidth == 32 ? ~Mask{0} : (Mask{1} << kWidth) - 1;
+
+template <class Classify, class Predicate>
+const char* Skip(const char* begin, const char* end, Classify classify, Predicate predicate) {
+    while (end - begin >= static_cast<ptrdiff_t>(kWidth)) {
+        Mask outside = ~ToMask(classify(Load(begin))) & kFullMask;
+        if (outside != 0) {
+            return begin + __builtin_ctz(outside);
+        }
+        begin += kWidth;
+    }
+    return ScalarSkip(begin, end, predicate);
+}
+
+#else
+
+template <class Classify, class Predicate>
+const char* Skip(const char* begin, const char* end, Classify, Predicate predicate) {
+    return ScalarSkip(begin, end, predicate);
+}
+
+#endif
+
+}  // namespace
+
+const char* SkipSpaces(const char* begin, const char* end) {
+    auto classify = [](auto v) { return Or(Or(Equal(v, ' '), Equal(v, '\t')), Equal(v, '\n')); };
+    return Skip(begin, end, classify, IsSpace);
+}
+
+const char* SkipDigits(const char* begin, const char* end) {
+    auto classify = [](auto v) { return InRange(v, '0', '9'); };
+    return Skip(begin, end, classify, IsDigit);
+}
+
+const char* SkipSymbolChars(const char* begin, const char* end) {
+    // ! # * + - 0..9 <..? A..z
+    auto classify = [](auto v) {
+        return Or(Or(Or(Equal(v, '!'), Equal(v, '#')), Or(InRange(v, '*', '+'), Equal(v, '-'))),
+                  Or(Or(InRange(v, '0', '9'), InRange(v, '<', '?')), InRange(v, 'A', 'z')));
+    };
+    return Skip(begin, end, classify, IsSymbolChar);
+}
+
+const char* SkipSpacesScalar(const char* begin, const char* end) {
+    return ScalarSkip(begin, end, IsSpace);
+}
+
+const char* SkipDigitsScalar(const char* begin, const char* end) {
+    return ScalarSkip(begin, end, IsDigit);
+}
+
+const char* SkipSymbolCharsScalar(const char* begin, const char* end) {
+    return ScalarSkip(begin, end, IsSymbolChar);
+}
+
+uint64_t ParseDigits(std::string_view digits) {
+    uint64_t res = 0;
+    size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Eight digits at a time: subtract '0' from every byte, then combine pairs,
+    // quads and octets of digits with multiply-and-shift.
+    for (; i + 8 <= digits.size(); i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, digits.data() + i, 8);
+        chunk -= 0x3030303030303030ULL;
+        chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+        chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+        chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+        res = res * 100000000u + chunk;
+    }
+#endif
+    for (; i < digits.size(); ++i) {
+        res = res * 10 + (digits[i] - '0');
+    }
+    return res;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Character classes of the tokenizer and the bulk scans over them. The scans
+// classify a whole vector register of characters per step where SSE2 or AVX2
+// is available and fall back to a scalar loop otherwise.
+
+inline bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n';
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsSymbolStart(char c) {
+    return (c >= 'A' && c <= 'z') || c == '#' || c == '*' || (c >= '<' && c <= '>');
+}
+
+inline bool IsSymbolChar(char c) {
+    return IsSymbolStart(c) || IsDigit(c) || c == '!' || c == '?' || c == '-' || c == '+';
+}
+
+// Each returns the first position in [begin, end) whose character is not in the class.
+const char* SkipSpaces(const char* begin, const char* end);
+const char* SkipDigits(const char* begin, const char* end);
+const char* SkipSymbolChars(const char* begin, const char* end);
+
+// The same scans one character at a time, whatever the target, to compare
+// the vector ones against.
+const char* SkipSpacesScalar(const char* begin, const char* end);
+const char* SkipDigitsScalar(const char* begin, const char* end);
+const char* SkipSymbolCharsScalar(const char* begin, const char* end);
+
+// Value of a run of decimal digits. Exact for up to kMaxExactDigits digits.
+constexpr size_t kMaxExactDigits = 18;
+uint64_t ParseDigits(std::string_view digits);
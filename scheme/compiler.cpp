@@ -0,0 +1,331 @@
+#include "compiler.h"
+
+#include <algorithm>
+#include <iterator>
+
+Code Compiler::Compile(Object* expr) {
+    Compiler compiler;
+    compiler.CompileExpression(expr, true);
+    compiler.Emit(OpCode::RETURN);
+    compiler.Run();
+    return std::move(compiler.code_);
+}
+
+Code Compiler::CompileBody(Object* body) {
+    Compiler compiler;
+    compiler.CompileSequence(body, true);
+    compiler.Emit(OpCode::RETURN);
+    compiler.Run();
+    return std::move(compiler.code_);
+}
+
+void Compiler::Run() {
+    do {
+        steps_.insert(steps_.end(), queued_.rbegin(), queued_.rend());
+        queued_.clear();
+        Step step = steps_.back();
+        steps_.pop_back();
+        switch (step.kind) {
+            case Step::Kind::EXPRESSION:
+                tail_ = step.tail;
+                CompileTerm(step.expr);
+                break;
+            case Step::Kind::INSTRUCTION:
+                if (step.jump != kNoJump) {
+                    jumps_[step.jump] = code_.instructions.size();
+                }
+                code_.instructions.push_back(step.instruction);
+                depth_ += step.depth_delta;
+                code_.max_stack = std::max(code_.max_stack, depth_);
+                break;
+            case Step::Kind::PATCH:
+                code_.instructions[jumps_[step.jump]].a = code_.instructions.size();
+                break;
+        }
+    } while (!steps_.empty() || !queued_.empty());
+}
+
+void Compiler::CompileExpression(Object* expr, bool tail) {
+    Step step{Step::Kind::EXPRESSION};
+    step.expr = expr;
+    step.tail = tail;
+    queued_.push_back(step);
+}
+
+void Compiler::CompileTerm(Object* expr) {
+    if (IsSelfEvaluating(expr)) {
+        EmitConstant(expr);
+        return;
+    }
+    if (Is<LocalRef>(expr) || Is<GlobalRef>(expr)) {
+        EmitLoad(expr);
+        return;
+    }
+    if (Is<Lambda>(expr)) {
+        EmitClosure(As<Lambda>(expr));
+        return;
+    }
+    if (!Is<Cell>(expr)) {
+        EmitFail();
+        return;
+    }
+    Cell* call = As<Cell>(expr);
+    Function* func = FindFunction(call->first_);
+    if (func == nullptr) {
+        CompileExpression(call->first_);
+        EmitApply(CompileArguments(call->second_));
+        return;
+    }
+    func->Compile(this, call);
+}
+
+void Compiler::CompileSequence(Object* forms, bool tail) {
+    for (Object* rest = forms; rest != nullptr; rest = As<Cell>(rest)->second_) {
+        if (rest != forms) {
+            EmitPop();
+        }
+        CompileExpression(As<Cell>(rest)->first_, tail && As<Cell>(rest)->second_ == nullptr);
+    }
+}
+
+uint32_t Compiler::CompileArguments(Object* args_head) {
+    uint32_t argc = 0;
+    while (args_head != nullptr) {
+        if (!Is<Cell>(args_head)) {
+            EmitConstant(args_head);
+            ++argc;
+            break;
+        }
+        Cell* now_cell = As<Cell>(args_head);
+        if (now_cell->first_ == nullptr && now_cell->second_ == nullptr) {
+            break;
+        }
+        if (now_cell->first_ != nullptr) {
+            CompileExpression(now_cell->first_);
+            ++argc;
+        }
+        args_head = now_cell->second_;
+    }
+    return argc;
+}
+
+void Compiler::EmitConstant(Object* value) {
+    Emit(OpCode::PUSH, code_.constants.size(), 0, 1);
+    code_.constants.push_back(value);
+}
+
+void Compiler::EmitCall(StrictFunction* func, uint32_t argc) {
+    static constexpr OpCode kFixedArity[] = {OpCode::CALL, OpCode::CALL1, OpCode::CALL2,
+                                              OpCode::CALL3};
+    Emit(argc < std::size(kFixedArity) ? kFixedArity[argc] : OpCode::CALL,
+         code_.functions.size(), argc, 1 - static_cast<int64_t>(argc));
+    code_.functions.push_back(func);
+}
+
+void Compiler::EmitFail() {
+    // Counts as producing a value, so the code after it stays balanced.
+    Emit(OpCode::FAIL, 0, 0, 1);
+}
+
+void Compiler::EmitPop() {
+    Emit(OpCode::POP, 0, 0, -1);
+}
+
+void Compiler::EmitLoad(Object* variable) {
+    if (LocalRef* local = As<LocalRef>(variable)) {
+        Emit(OpCode::LOAD_LOCAL, local->GetDepth(), local->GetSlot(), 1);
+    } else {
+        Emit(OpCode::LOAD_GLOBAL, AddGlobal(variable), 0, 1);
+    }
+}
+
+void Compiler::EmitStore(Object* variable, bool define) {
+    if (LocalRef* local = As<LocalRef>(variable)) {
+        Emit(OpCode::STORE_LOCAL, local->GetDepth(), local->GetSlot());
+    } else {
+        Emit(define ? OpCode::DEFINE_GLOBAL : OpCode::STORE_GLOBAL, AddGlobal(variable));
+    }
+}
+
+void Compiler::EmitClosure(Lambda* lambda) {
+    Emit(OpCode::CLOSURE, code_.constants.size(), 0, 1);
+    code_.constants.push_back(lambda);
+}
+
+void Compiler::EmitApply(uint32_t argc) {
+    Emit(tail_ ? OpCode::TAIL_APPLY : OpCode::APPLY, 0, argc, -static_cast<int64_t>(argc));
+}
+
+size_t Compiler::EmitJump(OpCode op) {
+    jumps_.push_back(0);
+    Emit(op, 0, 0, -1, jumps_.size() - 1);
+    return jumps_.size() - 1;
+}
+
+void Compiler::PatchJump(size_t jump) {
+    Step step{Step::Kind::PATCH};
+    step.jump = jump;
+    queued_.push_back(step);
+}
+
+void Compiler::Emit(OpCode op, uint32_t a, uint32_t b, int64_t depth_delta, size_t jump) {
+    Step step{Step::Kind::INSTRUCTION};
+    step.instruction = Instruction{op, a, b};
+    step.depth_delta = depth_delta;
+    step.jump = jump;
+    queued_.push_back(step);
+}
+
+uint32_t Compiler::AddGlobal(Object* variable) {
+    code_.globals.push_back(As<GlobalRef>(variable)->GetVariable());
+    return code_.globals.size() - 1;
+}
+
+const Code& Lambda::GetCode() {
+    if (!code_) {
+        code_ = Compiler::CompileBody(body_);
+    }
+    return *code_;
+}
+
+void StrictFunction::Compile(Compiler* compiler, Cell* call) {
+    if (!AcceptsShape(call->second_)) {
+        compiler->EmitFail();
+        return;
+    }
+    compiler->EmitCall(this, compiler->CompileArguments(call->second_));
+}
+
+void Quote::Compile(Compiler* compiler, Cell* call) {
+    compiler->EmitConstant(call->second_ == nullptr ? EmptyList() : call->second_);
+}
+
+void Liist::Compile(Compiler* compiler, Cell* call) {
+    compiler->EmitConstant(call->second_ == nullptr ? EmptyList() : call->second_);
+}
+
+void IsNull::Compile(Compiler* compiler, Cell* call) {
+    if (!Is<Cell>(call->second_)) {
+        compiler->EmitFail();
+        return;
+    }
+    compiler->CompileExpression(As<Cell>(call->second_)->first_);
+    compiler->EmitCall(this, 1);
+}
+
+namespace {
+
+// and/or stop at the first argument that is false, or true, and give its value.
+void CompileShortCircuit(Compiler* compiler, Object* args_head, Object* empty, OpCode jump) {
+    if (args_head == nullptr) {
+        compiler->EmitConstant(empty);
+        return;
+    }
+    std::vector<size_t> exits;
+    Cell* now_cell = As<Cell>(args_head);
+    for (; now_cell->second_ != nullptr; now_cell = As<Cell>(now_cell->second_)) {
+        compiler->CompileExpression(now_cell->first_);
+        exits.push_back(compiler->EmitJump(jump));
+    }
+    compiler->CompileExpression(now_cell->first_, compiler->IsTail());
+    for (size_t exit : exits) {
+        compiler->PatchJump(exit);
+    }
+}
+
+// when and unless: skip is the jump over the body.
+void CompileGuarded(Compiler* compiler, Cell* call, OpCode skip) {
+    Cell* test = As<Cell>(call->second_);
+    compiler->CompileExpression(test->first_);
+    size_t to_skip = compiler->EmitJump(skip);
+    compiler->CompileSequence(test->second_, compiler->IsTail());
+    size_t to_end = compiler->EmitJump(OpCode::JUMP);
+    compiler->PatchJump(to_skip);
+    compiler->EmitConstant(EmptyList());
+    compiler->PatchJump(to_end);
+}
+
+}  // namespace
+
+void And::Compile(Compiler* compiler, Cell* call) {
+    CompileShortCircuit(compiler, call->second_, True(), OpCode::JUMP_IF_FALSE_OR_POP);
+}
+
+void Or::Compile(Compiler* compiler, Cell* call) {
+    CompileShortCircuit(compiler, call->second_, False(), OpCode::JUMP_IF_TRUE_OR_POP);
+}
+
+void If::Compile(Compiler* compiler, Cell* call) {
+    Cell* test = As<Cell>(call->second_);
+    Cell* branches = As<Cell>(test->second_);
+    compiler->CompileExpression(test->first_);
+    size_t to_alternative = compiler->EmitJump(OpCode::JUMP_IF_FALSE);
+    compiler->CompileExpression(branches->first_, compiler->IsTail());
+    size_t to_end = compiler->EmitJump(OpCode::JUMP);
+    compiler->PatchJump(to_alternative);
+    if (branches->second_ == nullptr) {
+        compiler->EmitConstant(EmptyList());
+    } else {
+        compiler->CompileExpression(As<Cell>(branches->second_)->first_, compiler->IsTail());
+    }
+    compiler->PatchJump(to_end);
+}
+
+void Cond::Compile(Compiler* compiler, Cell* call) {
+    std::vector<size_t> exits;
+    bool has_else = false;
+    for (Object* clauses = call->second_; clauses != nullptr;
+         clauses = As<Cell>(clauses)->second_) {
+        Cell* clause = As<Cell>(As<Cell>(clauses)->first_);
+        if (IsElse(clause->first_)) {
+            compiler->CompileSequence(clause->second_, compiler->IsTail());
+            has_else = true;
+            break;
+        }
+        compiler->CompileExpression(clause->first_);
+        if (clause->second_ == nullptr) {
+            exits.push_back(compiler->EmitJump(OpCode::JUMP_IF_TRUE_OR_POP));
+            continue;
+        }
+        size_t to_next = compiler->EmitJump(OpCode::JUMP_IF_FALSE);
+        compiler->CompileSequence(clause->second_, compiler->IsTail());
+        exits.push_back(compiler->EmitJump(OpCode::JUMP));
+        compiler->PatchJump(to_next);
+    }
+    if (!has_else) {
+        compiler->EmitConstant(EmptyList());
+    }
+    for (size_t exit : exits) {
+        compiler->PatchJump(exit);
+    }
+}
+
+void When::Compile(Compiler* compiler, Cell* call) {
+    CompileGuarded(compiler, call, OpCode::JUMP_IF_FALSE);
+}
+
+void Unless::Compile(Compiler* compiler, Cell* call) {
+    CompileGuarded(compiler, call, OpCode::JUMP_IF_TRUE);
+}
+
+void LambdaForm::Compile(Compiler* compiler, Cell*) {
+    compiler->EmitFail();
+}
+
+void LetForm::Compile(Compiler* compiler, Cell*) {
+    compiler->EmitFail();
+}
+
+void DefineForm::Compile(Compiler* compiler, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    compiler->CompileExpression(As<Cell>(args->second_)->first_);
+    compiler->EmitStore(args->first_, true);
+    compiler->EmitPop();
+    compiler->EmitConstant(MakeSymbol(GetVariableName(args->first_)));
+}
+
+void SetForm::Compile(Compiler* compiler, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    compiler->CompileExpression(As<Cell>(args->second_)->first_);
+    compiler->EmitStore(args->first_, false);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "bytecode.h"
+#include "object.h"
+
+#include <cstdint>
+#include <vector>
+
+// Turns a parsed expression into Code. Builtins drive the compilation of their
+// own calls through Function::Compile, using the Emit* primitives below.
+//
+// The tree is walked with an explicit stack instead of recursion, like the
+// reader does. The Compile* and Emit* calls of a builtin are queued and
+// carried out in order once its Compile returns, each subexpression's code
+// in its place, so the native stack use does not depend on the nesting depth.
+class Compiler {
+public:
+    static Code Compile(Object* expr);
+
+    // Code that evaluates the expressions of a lambda body in turn and returns the last value.
+    static Code CompileBody(Object* body);
+
+    // Emits code that leaves the value of expr on the stack. In tail position
+    // the value of expr is the result of the code, and calls of closures
+    // become tail calls.
+    void CompileExpression(Object* expr, bool tail = false);
+
+    // Whether the expression being compiled is in tail position.
+    bool IsTail() const {
+        return tail_;
+    }
+
+    // Emits code for a non-empty list of forms that leaves the value of the
+    // last one, which is in tail position if the list is.
+    void CompileSequence(Object* forms, bool tail);
+
+    // Emits code that pushes the arguments the way TakeElem evaluates them and
+    // returns how many there are.
+    uint32_t CompileArguments(Object* args_head);
+
+    void EmitConstant(Object* value);
+    void EmitCall(StrictFunction* func, uint32_t argc);
+    void EmitFail();
+    void EmitPop();
+
+    // Variables are LocalRefs or GlobalRefs. A store leaves the value on the stack.
+    void EmitLoad(Object* variable);
+    void EmitStore(Object* variable, bool define);
+
+    void EmitClosure(Lambda* lambda);
+
+    // Calls the closure below the top argc values with them, as a tail call
+    // in tail position.
+    void EmitApply(uint32_t argc);
+
+    // Emits a jump and returns a handle to it for PatchJump. The code after a
+    // jump has one value less on the stack: a conditional one pops it when it
+    // falls through, and an unconditional one takes it to the target.
+    size_t EmitJump(OpCode op);
+
+    // Points the jump to the next instruction emitted.
+    void PatchJump(size_t jump);
+
+private:
+    // One item of work: compile an expression, emit an instruction, or point
+    // a jump at the end of the code.
+    struct Step {
+        enum class Kind { EXPRESSION, INSTRUCTION, PATCH };
+
+        Kind kind;
+        Object* expr = nullptr;
+        bool tail = false;
+        Instruction instruction{};
+        // Change of the stack depth the instruction makes.
+        int64_t depth_delta = 0;
+        // The handle of a jump, or kNoJump.
+        size_t jump = kNoJump;
+    };
+
+    static constexpr size_t kNoJump = SIZE_MAX;
+
+    // Carries out the queued steps, each one followed by the steps it queues.
+    void Run();
+
+    void CompileTerm(Object* expr);
+    void Emit(OpCode op, uint32_t a = 0, uint32_t b = 0, int64_t depth_delta = 0,
+              size_t jump = kNoJump);
+    uint32_t AddGlobal(Object* variable);
+
+    Code code_;
+    size_t depth_ = 0;
+    bool tail_ = false;
+    // Position of each jump emitted, by handle.
+    std::vector<size_t> jumps_;
+    // Steps still to run, the next one last.
+    std::vector<Step> steps_;
+    // Steps queued by the step being run, in order.
+    std::vector<Step> queued_;
+};
@@ -0,0 +1,17 @@
+#include "environment.h"
+
+GlobalVariable* GlobalEnvironment::Get(SymbolId name) {
+    std::unique_ptr<GlobalVariable>& variable = variables_[name];
+    if (variable == nullptr) {
+        variable = std::make_unique<GlobalVariable>(GlobalVariable{name});
+    }
+    return variable.get();
+}
+
+void GlobalEnvironment::AppendRoots(std::vector<Object*>* roots) const {
+    for (const auto& [name, variable] : variables_) {
+        if (variable->value != nullptr) {
+            roots->push_back(variable->value);
+        }
+    }
+}
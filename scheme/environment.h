@@ -0,0 +1,21 @@
+#pragma once
+
+#include "object.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// The top-level variables of an interpreter. A variable keeps its address for
+// as long as the environment lives, so resolved code refers to it directly.
+class GlobalEnvironment {
+public:
+    // The variable called name, created without a value if there is none yet.
+    GlobalVariable* Get(SymbolId name);
+
+    // The values of the defined variables, which the collector has to keep.
+    void AppendRoots(std::vector<Object*>* roots) const;
+
+private:
+    std::unordered_map<SymbolId, std::unique_ptr<GlobalVariable>> variables_;
+};
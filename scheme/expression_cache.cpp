@@ -0,0 +1,43 @@
+#include "expression_cache.h"
+
+void ExpressionCache::SetCapacity(size_t capacity) {
+    capacity_ = capacity;
+    Shrink();
+}
+
+void ExpressionCache::Clear() {
+    index_.clear();
+    items_.clear();
+}
+
+ExpressionCache::Entry* ExpressionCache::Find(std::string_view source) {
+    auto it = index_.find(source);
+    if (it == index_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    items_.splice(items_.begin(), items_, it->second);
+    return &it->second->second;
+}
+
+ExpressionCache::Entry* ExpressionCache::Insert(std::string_view source, Object* expr) {
+    items_.emplace_front(std::string(source), Entry{expr, std::nullopt});
+    index_.emplace(items_.front().first, items_.begin());
+    Shrink();
+    return &items_.front().second;
+}
+
+void ExpressionCache::AppendRoots(std::vector<Object*>* roots) const {
+    for (const Item& item : items_) {
+        roots->push_back(item.second.expr);
+    }
+}
+
+void ExpressionCache::Shrink() {
+    while (items_.size() > capacity_) {
+        index_.erase(items_.back().first);
+        items_.pop_back();
+        ++stats_.evictions;
+    }
+}
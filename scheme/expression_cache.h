@@ -0,0 +1,61 @@
+#pragma once
+
+#include "bytecode.h"
+#include "object.h"
+
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+};
+
+// Least recently used map from source text to its parsed form and, once it
+// has been needed, its bytecode. A capacity of zero disables the cache.
+class ExpressionCache {
+public:
+    struct Entry {
+        Object* expr = nullptr;
+        std::optional<Code> code;
+    };
+
+    size_t GetCapacity() const {
+        return capacity_;
+    }
+
+    // Evicts the least recently used entries that no longer fit.
+    void SetCapacity(size_t capacity);
+
+    void Clear();
+
+    // Counts a hit or a miss. A hit becomes the most recently used entry.
+    Entry* Find(std::string_view source);
+
+    // source must not be in the cache yet, and the capacity must not be zero.
+    Entry* Insert(std::string_view source, Object* expr);
+
+    // The parsed forms of all entries, which the collector has to keep.
+    void AppendRoots(std::vector<Object*>* roots) const;
+
+    const CacheStats& GetStats() const {
+        return stats_;
+    }
+
+private:
+    using Item = std::pair<std::string, Entry>;
+
+    void Shrink();
+
+    size_t capacity_ = 0;
+    // Most recently used first. The keys of index_ point into the list nodes,
+    // which stay where they are until erased.
+    std::list<Item> items_;
+    std::unordered_map<std::string_view, std::list<Item>::iterator> index_;
+    CacheStats stats_;
+};
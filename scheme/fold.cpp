@@ -0,0 +1,113 @@
+#include "fold.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+bool IsLiteral(Object* expr) {
+    if (IsSelfEvaluating(expr)) {
+        return true;
+    }
+    if (!Is<Cell>(expr)) {
+        return false;
+    }
+    Function* func = FindFunction(As<Cell>(expr)->first_);
+    return func != nullptr && func->GetFolding() == Folding::CONSTANT;
+}
+
+// An expression that evaluates to value.
+Object* MakeLiteral(Object* value) {
+    if (IsSelfEvaluating(value)) {
+        return value;
+    }
+    static const SymbolId kQuote = Intern("quote");
+    Cell* quote = Make<Cell>();
+    quote->first_ = MakeSymbol(kQuote);
+    quote->second_ = value;
+    return quote;
+}
+
+bool IsProperList(Object* args_head) {
+    while (args_head != nullptr) {
+        Cell* now_cell = As<Cell>(args_head);
+        if (now_cell == nullptr || now_cell->first_ == nullptr) {
+            return false;
+        }
+        args_head = now_cell->second_;
+    }
+    return true;
+}
+
+// An expression to fold in place, and whether the arguments of the call in
+// it have been folded already.
+struct FoldStep {
+    Object** expr;
+    bool arguments_folded = false;
+};
+
+// Queues the expressions of a proper list, the first one on top.
+void PushEach(Object* expressions, std::vector<FoldStep>* stack) {
+    size_t begin = stack->size();
+    for (; expressions != nullptr; expressions = As<Cell>(expressions)->second_) {
+        stack->push_back(FoldStep{&As<Cell>(expressions)->first_});
+    }
+    std::reverse(stack->begin() + begin, stack->end());
+}
+
+bool AllLiterals(Object* expressions) {
+    for (; expressions != nullptr; expressions = As<Cell>(expressions)->second_) {
+        if (!IsLiteral(As<Cell>(expressions)->first_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// The tree is walked with an explicit stack, like the reader does. A pure
+// call is visited twice: first to queue its arguments, then, once they are
+// folded, to fold the call itself.
+Object* FoldConstants(Object* expr) {
+    std::vector<FoldStep> stack{FoldStep{&expr}};
+    while (!stack.empty()) {
+        FoldStep step = stack.back();
+        stack.pop_back();
+        if (Lambda* lambda = As<Lambda>(*step.expr)) {
+            PushEach(lambda->GetBody(), &stack);
+            continue;
+        }
+        Cell* call = As<Cell>(*step.expr);
+        if (call == nullptr || !IsProperList(call->second_)) {
+            continue;
+        }
+        Function* func = FindFunction(call->first_);
+        if (func == nullptr) {
+            // A closure call: the callee and the arguments are all expressions.
+            PushEach(call->second_, &stack);
+            stack.push_back(FoldStep{&call->first_});
+            continue;
+        }
+        Folding folding = func->GetFolding();
+        if (folding != Folding::ARGUMENTS && folding != Folding::PURE) {
+            continue;
+        }
+        if (!step.arguments_folded) {
+            if (folding == Folding::PURE) {
+                stack.push_back(FoldStep{step.expr, true});
+            }
+            PushEach(call->second_, &stack);
+            continue;
+        }
+        if (!AllLiterals(call->second_)) {
+            continue;
+        }
+        try {
+            *step.expr = MakeLiteral(Evaluate(call));
+        } catch (const std::runtime_error&) {
+        }
+    }
+    return expr;
+}
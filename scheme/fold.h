@@ -0,0 +1,14 @@
+#pragma once
+
+#include "object.h"
+
+// Replaces calls whose value is known before evaluation by that value, bottom
+// up, and returns the new expression. A call is folded if its builtin is
+// Folding::PURE, its arguments form a proper list and each of them is a
+// number, a symbol or a Folding::CONSTANT call such as a quote. Arguments
+// are folded inside any call whose arguments are expressions, including
+// closure calls, definitions and assignments, and so are lambda bodies. Only
+// positions that are evaluated are visited, so quoted data is never changed.
+// A call that raises an error is left in place to raise it when evaluated.
+// Expects a resolved expression.
+Object* FoldConstants(Object* expr);
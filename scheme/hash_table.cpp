@@ -0,0 +1,180 @@
+#include "hash_table.h"
+#include "arithmetic.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Lists hash by this many of their elements and nested lists at most this
+// deep, which keeps hashing a long list cheap; equality still looks at all.
+constexpr size_t kHashedElements = 16;
+constexpr size_t kHashedDepth = 4;
+
+// Spreads the bits of an integer over the whole word, see splitmix64.
+size_t Mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+size_t HashNumber(Number* number) {
+    if (number->IsSmall()) {
+        return Mix(number->GetValue());
+    }
+    if (number->GetKind() == NumberKind::REAL) {
+        double real = number->GetReal();
+        // Equal keys must hash alike: -0.0 equals 0.0. A NaN equals no key
+        // but itself, so any fixed pattern does for it.
+        if (real == 0.0) {
+            real = 0.0;
+        } else if (std::isnan(real)) {
+            real = std::numeric_limits<double>::quiet_NaN();
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &real, sizeof(bits));
+        return Mix(bits);
+    }
+    return std::hash<std::string>()(number->TakeStringValue());
+}
+
+size_t Hash(Object* key, size_t depth) {
+    key = ToValue(key);
+    if (Number* number = As<Number>(key)) {
+        return HashNumber(number);
+    }
+    if (Symbol* symbol = As<Symbol>(key)) {
+        return Mix(symbol->GetId());
+    }
+    if (!Is<Cell>(key)) {
+        return Mix(reinterpret_cast<uintptr_t>(key));
+    }
+    size_t hash = Mix(static_cast<uint64_t>(ObjectType::CELL));
+    if (depth == kHashedDepth) {
+        return hash;
+    }
+    Object* rest = key;
+    for (size_t i = 0; i < kHashedElements && Is<Cell>(rest); ++i) {
+        Cell* now_cell = As<Cell>(rest);
+        hash = Mix(hash + Hash(now_cell->first_, depth + 1));
+        rest = now_cell->second_;
+    }
+    return hash;
+}
+
+// Compares pairs from an explicit stack, so deeply nested keys do not use
+// native stack.
+bool Equal(Object* first, Object* second) {
+    std::vector<std::pair<Object*, Object*>> pending{{first, second}};
+    while (!pending.empty()) {
+        first = ToValue(pending.back().first);
+        second = ToValue(pending.back().second);
+        pending.pop_back();
+        if (first == second) {
+            continue;
+        }
+        if (Number* number = As<Number>(first)) {
+            Number* other = As<Number>(second);
+            if (other == nullptr || number->GetKind() != other->GetKind() ||
+                IsUnordered(number, other) || Compare(number, other) != 0) {
+                return false;
+            }
+            continue;
+        }
+        Cell* first_cell = As<Cell>(first);
+        Cell* second_cell = As<Cell>(second);
+        if (first_cell == nullptr || second_cell == nullptr) {
+            return false;
+        }
+        pending.emplace_back(first_cell->second_, second_cell->second_);
+        pending.emplace_back(first_cell->first_, second_cell->first_);
+    }
+    return true;
+}
+
+}  // namespace
+
+Object* HashTable::Find(Object* key) const {
+    if (size_ == 0) {
+        return nullptr;
+    }
+    return slots_[Probe(key, Hash(key, 0))].value;
+}
+
+void HashTable::Insert(Object* key, Object* value) {
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        Grow();
+    }
+    size_t hash = Hash(key, 0);
+    Slot& slot = slots_[Probe(key, hash)];
+    if (slot.key == nullptr) {
+        slot.key = ToValue(key);
+        slot.hash = hash;
+        ++size_;
+    }
+    slot.value = ToValue(value);
+}
+
+bool HashTable::Erase(Object* key) {
+    if (size_ == 0) {
+        return false;
+    }
+    size_t mask = slots_.size() - 1;
+    size_t hole = Probe(key, Hash(key, 0));
+    if (slots_[hole].key == nullptr) {
+        return false;
+    }
+    // Moves later entries of the run back into the hole when that does not
+    // put them before their home slot, so no tombstones are needed.
+    for (size_t next = (hole + 1) & mask; slots_[next].key != nullptr; next = (next + 1) & mask) {
+        size_t home = slots_[next].hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = Slot();
+    --size_;
+    return true;
+}
+
+void HashTable::Trace(std::vector<Object*>* out) {
+    for (const Slot& slot : slots_) {
+        if (slot.key != nullptr) {
+            out->push_back(slot.key);
+            out->push_back(slot.value);
+        }
+    }
+}
+
+size_t HashTable::Probe(Object* key, size_t hash) const {
+    size_t mask = slots_.size() - 1;
+    size_t index = hash & mask;
+    while (slots_[index].key != nullptr &&
+           (slots_[index].hash != hash || !Equal(slots_[index].key, key))) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void HashTable::Grow() {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(old.empty() ? 8 : old.size() * 2, Slot());
+    size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.key != nullptr) {
+            size_t index = slot.hash & mask;
+            while (slots_[index].key != nullptr) {
+                index = (index + 1) & mask;
+            }
+            slots_[index] = slot;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "object.h"
+
+#include <vector>
+
+// Mutable table from keys to values, with open addressing and linear probing.
+// Numbers are equal if they are of the same kind and value, so 0.0 and -0.0
+// are one key and a NaN only matches the very same object. Symbols are equal
+// if they are the same symbol, lists if their elements are equal, and any
+// other objects only if they are the same object. Fixnums and symbols hash
+// without touching memory, lists by their first elements.
+class HashTable : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::HASH_TABLE;
+
+    HashTable() : Object(kType) {
+    }
+
+    // The value stored under key, or nullptr if there is none.
+    Object* Find(Object* key) const;
+
+    void Insert(Object* key, Object* value);
+
+    // Returns whether key was in the table.
+    bool Erase(Object* key);
+
+    size_t Size() const {
+        return size_;
+    }
+
+    void Trace(std::vector<Object*>* out) override;
+
+    std::string TakeStringValue() override {
+        return "#<hash-table>";
+    }
+
+    Object* Calculate() override {
+        return this;
+    }
+
+private:
+    // Keys are never nullptr, see ToValue, so a null key marks a free slot.
+    struct Slot {
+        Object* key = nullptr;
+        Object* value = nullptr;
+        size_t hash = 0;
+    };
+
+    // The slot that holds key, or the free slot where probing for it stops.
+    size_t Probe(Object* key, size_t hash) const;
+
+    void Grow();
+
+    // A power of two in size, or empty.
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,117 @@
+#include "heap.h"
+#include "object.h"
+
+#include <algorithm>
+
+namespace {
+
+thread_local Heap* current_heap = nullptr;
+
+}  // namespace
+
+Heap::~Heap() {
+    for (Object* object : objects_) {
+        Destroy(object);
+    }
+}
+
+Heap& Heap::Current() {
+    if (current_heap != nullptr) {
+        return *current_heap;
+    }
+    static Heap default_heap;
+    return default_heap;
+}
+
+void* Heap::Allocate(size_t size) {
+    size_t size_class = SizeClass(size);
+    if (size_class >= kSizeClasses) {
+        return ::operator new(size);
+    }
+    if (FreeSlot* slot = free_lists_[size_class]) {
+        free_lists_[size_class] = slot->next;
+        return slot;
+    }
+    return chunks_.Allocate((size_class + 1) * kGranularity, kGranularity);
+}
+
+void Heap::Free(void* memory, size_t size) {
+    size_t size_class = SizeClass(size);
+    if (size_class >= kSizeClasses) {
+        ::operator delete(memory);
+        return;
+    }
+    FreeSlot* slot = static_cast<FreeSlot*>(memory);
+    slot->next = free_lists_[size_class];
+    free_lists_[size_class] = slot;
+}
+
+void Heap::Register(Object* object, size_t size) {
+    object->heap_size_ = size;
+    objects_.push_back(object);
+    allocated_since_collection_ += size;
+    stats_.bytes_allocated += size;
+    stats_.bytes_live += size;
+    ++stats_.objects_live;
+}
+
+void Heap::Destroy(Object* object) {
+    size_t size = object->heap_size_;
+    object->~Object();
+    Free(object, size);
+}
+
+void Heap::Collect(const std::vector<Object*>& roots) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Object*> gray;
+    auto mark = [&gray](Object* object) {
+        if (object != nullptr && object->heap_size_ != 0 && !object->marked_) {
+            object->marked_ = true;
+            gray.push_back(object);
+        }
+    };
+    for (Object* root : roots) {
+        mark(root);
+    }
+    std::vector<Object*> children;
+    while (!gray.empty()) {
+        Object* object = gray.back();
+        gray.pop_back();
+        children.clear();
+        object->Trace(&children);
+        for (Object* child : children) {
+            mark(child);
+        }
+    }
+
+    size_t kept = 0;
+    for (Object* object : objects_) {
+        if (object->marked_) {
+            object->marked_ = false;
+            objects_[kept++] = object;
+        } else {
+            stats_.bytes_freed += object->heap_size_;
+            stats_.bytes_live -= object->heap_size_;
+            Destroy(object);
+        }
+    }
+    objects_.resize(kept);
+    stats_.objects_live = kept;
+
+    allocated_since_collection_ = 0;
+    next_collection_ = std::max(kMinCollectionBytes, stats_.bytes_live);
+    auto pause = std::chrono::steady_clock::now() - start;
+    ++stats_.collections;
+    stats_.last_pause = pause;
+    stats_.max_pause = std::max<std::chrono::nanoseconds>(stats_.max_pause, pause);
+    stats_.total_pause += pause;
+}
+
+HeapScope::HeapScope(Heap* heap) : previous_(current_heap) {
+    current_heap = heap;
+}
+
+HeapScope::~HeapScope() {
+    current_heap = previous_;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "arena.h"
+
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+class Object;
+
+struct GcStats {
+    size_t collections = 0;
+    size_t objects_live = 0;
+    size_t bytes_live = 0;
+    size_t bytes_allocated = 0;
+    size_t bytes_freed = 0;
+    // Memory carved out of arena chunks; free list reuse does not add to it.
+    size_t chunk_bytes = 0;
+    size_t chunks = 0;
+    std::chrono::nanoseconds last_pause{0};
+    std::chrono::nanoseconds max_pause{0};
+    std::chrono::nanoseconds total_pause{0};
+};
+
+// Mark-sweep heap for Objects. Small objects come from size-segregated free
+// lists carved out of arena chunks, bigger ones straight from operator new.
+// Objects that are not allocated here (the shared canonical ones) are never
+// traced or freed.
+class Heap {
+public:
+    Heap() = default;
+    ~Heap();
+
+    Heap(const Heap&) = delete;
+    Heap& operator=(const Heap&) = delete;
+
+    // The heap of the innermost HeapScope, or a process-wide one outside of any.
+    static Heap& Current();
+
+    template <class T, class... Args>
+    T* Make(Args&&... args) {
+        void* memory = Allocate(sizeof(T));
+        T* object;
+        try {
+            object = new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            Free(memory, sizeof(T));
+            throw;
+        }
+        Register(object, sizeof(T));
+        return object;
+    }
+
+    // Allocates count default-constructed objects next to each other, so the
+    // result can be indexed like an array. Each one is still an object of its
+    // own for the collector and is freed on its own.
+    template <class T>
+    T* MakeRun(size_t count) {
+        static_assert(sizeof(T) % kGranularity == 0 && SizeClass(sizeof(T)) < kSizeClasses);
+        T* objects = static_cast<T*>(chunks_.Allocate(count * sizeof(T), kGranularity));
+        for (size_t i = 0; i < count; ++i) {
+            Register(new (objects + i) T(), sizeof(T));
+        }
+        return objects;
+    }
+
+    // Frees every object that is not reachable from roots. The caller must
+    // make sure no other pointers to heap objects are in use.
+    void Collect(const std::vector<Object*>& roots);
+
+    bool ShouldCollect() const {
+        return allocated_since_collection_ >= next_collection_;
+    }
+
+    GcStats GetStats() const {
+        GcStats stats = stats_;
+        stats.chunk_bytes = chunks_.BytesAllocated();
+        stats.chunks = chunks_.ChunkCount();
+        return stats;
+    }
+
+private:
+    static constexpr size_t kGranularity = 16;
+    static constexpr size_t kSizeClasses = 8;
+    static constexpr size_t kMinCollectionBytes = 1 << 20;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static constexpr size_t SizeClass(size_t size) {
+        return (size + kGranularity - 1) / kGranularity - 1;
+    }
+
+    void* Allocate(size_t size);
+    void Free(void* memory, size_t size);
+    void Register(Object* object, size_t size);
+    void Destroy(Object* object);
+
+    Arena chunks_;
+    FreeSlot* free_lists_[kSizeClasses] = {};
+    std::vector<Object*> objects_;
+    size_t allocated_since_collection_ = 0;
+    size_t next_collection_ = kMinCollectionBytes;
+    GcStats stats_;
+};
+
+class HeapScope {
+public:
+    explicit HeapScope(Heap* heap);
+    ~HeapScope();
+
+    HeapScope(const HeapScope&) = delete;
+    HeapScope& operator=(const HeapScope&) = delete;
+
+private:
+    Heap* previous_;
+};
+
+template <class T, class... Args>
+T* Make(Args&&... args) {
+    return Heap::Current().Make<T>(std::forward<Args>(args)...);
+}
+
+template <class T>
+T* MakeRun(size_t count) {
+    return Heap::Current().MakeRun<T>(count);
+}
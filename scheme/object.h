@@ -1,102 +1,337 @@
 #pragma once
 
+#include "bytecode.h"
+#include "heap.h"
+#include "small_vector.h"
 #include "tokenizer.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
 #include <memory>
-#include <map>
+#include <optional>
 #include <vector>
 
-class Object : public std::enable_shared_from_this<Object> {
+enum class ObjectType : uint8_t {
+    NUMBER,
+    SYMBOL,
+    DOT,
+    QUOTE,
+    BRACKET,
+    CELL,
+    FUNCTION,
+    VECTOR,
+    BYTEVECTOR,
+    HASH_TABLE,
+    FRAME,
+    LOCAL_REF,
+    GLOBAL_REF,
+    LAMBDA,
+    CLOSURE
+};
+
+class Object {
 public:
+    explicit Object(ObjectType type) : type_(type) {
+    }
+
     virtual ~Object() = default;
 
-    virtual std::string TakeStringValue(){};
+    ObjectType GetType() const {
+        return type_;
+    }
 
-    virtual std::string Inside(){};
+    virtual std::string TakeStringValue(){};
 
-    virtual std::shared_ptr<Object> Calculate() {
+    virtual Object* Calculate() {
         throw RuntimeError("");
     }
+
+    // Reports the objects this one references, for the collector.
+    virtual void Trace(std::vector<Object*>*) {
+    }
+
+protected:
+    // Room left in the header, which subclasses may use. See Cell::GetRun.
+    uint16_t header_extra_ = 0;
+
+private:
+    friend class Heap;
+
+    ObjectType type_;
+    bool marked_ = false;
+    // Size of the allocation if the object lives in a Heap, zero otherwise.
+    uint32_t heap_size_ = 0;
 };
 
+// Every concrete type declares its tag as T::kType; all builtins share FUNCTION.
 template <class T>
-std::shared_ptr<T> As(const std::shared_ptr<Object>& obj) {
-    return std::dynamic_pointer_cast<T>(obj);
+bool Is(const Object* obj) {
+    return obj != nullptr && obj->GetType() == T::kType;
 }
 
 template <class T>
-bool Is(const std::shared_ptr<Object>& obj) {
-    if (dynamic_cast<T*>(obj.get())) {
-        return true;
+T* As(Object* obj) {
+    if (!Is<T>(obj)) {
+        return nullptr;
     }
-    return false;
+    return static_cast<T*>(obj);
 }
 
+// Kinds of numbers in the order of contagion: an operation on two numbers
+// yields the later of their two kinds.
+enum class NumberKind : uint8_t { INTEGER, RATIONAL, REAL };
+
+// Integers that fit in int64_t are stored inline and larger ones as a BigInt,
+// so IsSmall() tells which representation is in use. Rationals keep their
+// numerator and denominator in lowest terms, reals are doubles.
 class Number : public Object {
 public:
-    Number(ConstantToken now) : mean_(now.value) {
+    static constexpr ObjectType kType = ObjectType::NUMBER;
+
+    Number(int64_t now) : Object(kType), mean_(now) {
+    }
+
+    // Callers keep big values that fit in int64_t small, see MakeNumber.
+    Number(BigInt now) : Object(kType), big_(std::make_unique<BigInt>(std::move(now))) {
+    }
+
+    // In lowest terms with a denominator above one, see MakeRational.
+    Number(BigInt numerator, BigInt denominator)
+        : Object(kType),
+          kind_(NumberKind::RATIONAL),
+          big_(std::make_unique<BigInt>(std::move(numerator))),
+          denominator_(std::make_unique<BigInt>(std::move(denominator))) {
+    }
+
+    Number(double now) : Object(kType), kind_(NumberKind::REAL), real_(now) {
     }
 
-    Number(int now) : mean_(now) {
+    NumberKind GetKind() const {
+        return kind_;
     }
 
-    int GetValue() const {
+    bool IsSmall() const {
+        return kind_ == NumberKind::INTEGER && big_ == nullptr;
+    }
+
+    // Only meaningful if IsSmall().
+    int64_t GetValue() const {
         return mean_;
     }
-    std::string TakeStringValue() override {
-        return std::to_string(mean_);
+
+    // Only meaningful for reals.
+    double GetReal() const {
+        return real_;
+    }
+
+    // Only meaningful for integers.
+    BigInt ToBig() const {
+        return big_ == nullptr ? BigInt(mean_) : *big_;
     }
 
-    std::string Inside() override {
-        return std::to_string(mean_);
+    // Integers are their own numerator over one. Only meaningful for exact numbers.
+    BigInt GetNumerator() const {
+        return ToBig();
     }
-    std::shared_ptr<Object> Calculate() override {
-        return shared_from_this();
+
+    BigInt GetDenominator() const {
+        return denominator_ == nullptr ? BigInt(1) : *denominator_;
+    }
+
+    double ToDouble() const {
+        switch (kind_) {
+            case NumberKind::REAL:
+                return real_;
+            case NumberKind::RATIONAL:
+                return big_->ToDouble() / denominator_->ToDouble();
+            default:
+                return big_ == nullptr ? mean_ : big_->ToDouble();
+        }
+    }
+
+    std::string TakeStringValue() override {
+        switch (kind_) {
+            case NumberKind::REAL:
+                return FormatReal(real_);
+            case NumberKind::RATIONAL:
+                return big_->ToString() + "/" + denominator_->ToString();
+            default:
+                return big_ == nullptr ? std::to_string(mean_) : big_->ToString();
+        }
+    }
+
+    Object* Calculate() override {
+        return this;
     }
 
 private:
-    ConstantToken value_;
-    int mean_;
+    // Shortest text that reads back as the same double, always with a point or
+    // an exponent so it does not look like an integer.
+    static std::string FormatReal(double value) {
+        if (std::isnan(value)) {
+            return "+nan.0";
+        }
+        if (std::isinf(value)) {
+            return value > 0 ? "+inf.0" : "-inf.0";
+        }
+        char buffer[32];
+        std::string res(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+        size_t exponent = res.find('e');
+        if (exponent == std::string::npos) {
+            if (res.find('.') == std::string::npos) {
+                res += ".0";
+            }
+        } else if (res[exponent + 1] == '+') {
+            res.erase(exponent + 1, 1);
+        }
+        return res;
+    }
+
+    NumberKind kind_ = NumberKind::INTEGER;
+    union {
+        int64_t mean_ = 0;
+        double real_;
+    };
+    // A big integer, or the numerator of a rational.
+    std::unique_ptr<BigInt> big_;
+    std::unique_ptr<BigInt> denominator_;
 };
 
+constexpr int kMinCachedNumber = -128;
+constexpr int kMaxCachedNumber = 1023;
+
+// Numbers are immutable, so values from kMinCachedNumber to kMaxCachedNumber are
+// shared instead of allocated per result. Fixnums are not immediates: any other
+// value is allocated on the current Heap, like a big integer. The shared ones
+// live outside of any Heap and are never freed.
+inline Number* MakeNumber(int64_t value) {
+    static const std::vector<std::unique_ptr<Number>> kCache = [] {
+        std::vector<std::unique_ptr<Number>> cache;
+        for (int64_t i = kMinCachedNumber; i <= kMaxCachedNumber; ++i) {
+            cache.push_back(std::make_unique<Number>(i));
+        }
+        return cache;
+    }();
+    if (value < kMinCachedNumber || value > kMaxCachedNumber) {
+        return Make<Number>(value);
+    }
+    return kCache[value - kMinCachedNumber].get();
+}
+
+inline Number* MakeNumber(BigInt value) {
+    if (value.FitsInt64()) {
+        return MakeNumber(value.ToInt64());
+    }
+    return Make<Number>(std::move(value));
+}
+
+inline Number* MakeReal(double value) {
+    return Make<Number>(value);
+}
+
+// Reduces numerator / denominator to lowest terms; an integer if that is what
+// it comes down to. Throws RuntimeError if the denominator is zero.
+Number* MakeRational(BigInt numerator, BigInt denominator);
+
+inline Number* MakeNumber(const ConstantToken& token) {
+    if (token.real) {
+        return MakeReal(*token.real);
+    }
+    if (token.denominator) {
+        return MakeRational(token.big ? *token.big : BigInt(token.value), *token.denominator);
+    }
+    if (token.big) {
+        return MakeNumber(*token.big);
+    }
+    return MakeNumber(token.value);
+}
+
 class Symbol : public Object {
 public:
-    Symbol(Token now) {
+    static constexpr ObjectType kType = ObjectType::SYMBOL;
+
+    Symbol(Token now) : Object(kType) {
         if (const SymbolToken* btw1 = std::get_if<SymbolToken>(&now)) {
-            str_ = btw1->name;
-            value_ = *btw1;
-        } else if (const DotToken* btw3 = std::get_if<DotToken>(&now)) {
-            str_ = ".";
-            value_ = *btw3;
+            id_ = btw1->id;
+        } else if (std::get_if<DotToken>(&now)) {
+            id_ = kDotSymbol;
         }
     }
 
-    Symbol(std::string str) : str_(str){};
+    Symbol(std::string_view str) : Object(kType), id_(Intern(str)){};
 
-    const std::string& GetName() const {
-        return str_;
+    Symbol(SymbolId id) : Object(kType), id_(id){};
+
+    SymbolId GetId() const {
+        return id_;
     }
 
-    std::string TakeStringValue() override {
-        return str_;
+    const std::string& GetName() const {
+        return SymbolName(id_);
     }
 
-    std::string Inside() override {
-        return str_;
+    std::string TakeStringValue() override {
+        return GetName();
     }
 
-    std::shared_ptr<Object> Calculate() override {
-        return shared_from_this();
+    Object* Calculate() override {
+        return this;
     }
 
 private:
-    std::variant<SymbolToken, QuoteToken, DotToken> value_;
-    std::string str_;
+    SymbolId id_ = kDotSymbol;
 };
 
+// There is exactly one Symbol object per interned id, so symbols (#t, #f and ()
+// included) can be compared by pointer. Like the cached numbers they are never freed.
+inline Object* MakeSymbol(SymbolId id) {
+    static std::vector<std::unique_ptr<Symbol>> symbols;
+    if (symbols.size() <= id) {
+        symbols.resize(SymbolTable::Instance().Size());
+    }
+    if (symbols[id] == nullptr) {
+        symbols[id] = std::make_unique<Symbol>(id);
+    }
+    return symbols[id].get();
+}
+
+inline Object* True() {
+    static Object* const kTrue = MakeSymbol(kTrueSymbol);
+    return kTrue;
+}
+
+inline Object* False() {
+    static Object* const kFalse = MakeSymbol(kFalseSymbol);
+    return kFalse;
+}
+
+inline Object* EmptyList() {
+    static Object* const kEmptyList = MakeSymbol(kEmptyListSymbol);
+    return kEmptyList;
+}
+
+inline Object* MakeBool(bool value) {
+    return value ? True() : False();
+}
+
+// Conditions accept any value: only #f is false.
+inline bool IsTruthy(Object* value) {
+    return value != False();
+}
+
+// Lists end in nullptr, but variables and vectors hold EmptyList() instead,
+// so that nullptr can mean that there is no value at all.
+inline Object* ToValue(Object* obj) {
+    return obj == nullptr ? EmptyList() : obj;
+}
+
 class SymbolDot : public Object {
 public:
-    SymbolDot(DotToken btw) {
+    static constexpr ObjectType kType = ObjectType::DOT;
+
+    SymbolDot(DotToken btw) : Object(kType) {
         str_ = ".";
         value_ = btw;
     }
@@ -105,10 +340,6 @@ public:
         return ".";
     }
 
-    std::string Inside() override {
-        return str_;
-    }
-
 private:
     DotToken value_;
     std::string str_;
@@ -116,7 +347,9 @@ private:
 
 class SymbolQuote : public Object {
 public:
-    SymbolQuote(QuoteToken btw) {
+    static constexpr ObjectType kType = ObjectType::QUOTE;
+
+    SymbolQuote(QuoteToken btw) : Object(kType) {
         str_ = "\'";
         value_ = btw;
     }
@@ -125,10 +358,6 @@ public:
         return str_;
     }
 
-    std::string Inside() override {
-        return str_;
-    }
-
 private:
     QuoteToken value_;
     std::string str_;
@@ -136,7 +365,9 @@ private:
 
 class SymbolBracket : public Object {
 public:
-    SymbolBracket(BracketToken btw) {
+    static constexpr ObjectType kType = ObjectType::BRACKET;
+
+    SymbolBracket(BracketToken btw) : Object(kType) {
         if (btw == BracketToken::OPEN) {
             str_ = "(";
             value_ = btw;
@@ -150,252 +381,874 @@ public:
         return str_;
     }
 
-    std::string Inside() override {
-        return str_;
-    }
-
 private:
     BracketToken value_;
     std::string str_;
 };
 
-std::vector<std::shared_ptr<Object>> TakeElem(std::shared_ptr<Object> args_head);
+// Fixed-length array of objects, stored contiguously so indexing is O(1).
+// An empty list is kept as EmptyList(), see ToValue.
+class Vector : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::VECTOR;
+
+    explicit Vector(std::vector<Object*> elements)
+        : Object(kType), elements_(std::move(elements)) {
+        std::transform(elements_.begin(), elements_.end(), elements_.begin(), ToValue);
+    }
+
+    size_t Size() const {
+        return elements_.size();
+    }
+
+    Object* Get(size_t index) const {
+        return elements_[index];
+    }
+
+    // Literals read from source are shared by every evaluation of the form,
+    // so the mutating builtins refuse them.
+    bool IsLiteral() const {
+        return header_extra_ != 0;
+    }
+
+    void MarkLiteral() {
+        header_extra_ = 1;
+    }
+
+    void Set(size_t index, Object* value) {
+        elements_[index] = ToValue(value);
+    }
+
+    void Fill(Object* value) {
+        std::fill(elements_.begin(), elements_.end(), ToValue(value));
+    }
+
+    void Trace(std::vector<Object*>* out) override {
+        out->insert(out->end(), elements_.begin(), elements_.end());
+    }
+
+    // See Print.
+    std::string TakeStringValue() override;
+
+    Object* Calculate() override {
+        return this;
+    }
+
+private:
+    std::vector<Object*> elements_;
+};
+
+// Fixed-length array of bytes.
+class Bytevector : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::BYTEVECTOR;
+
+    explicit Bytevector(std::vector<uint8_t> bytes) : Object(kType), bytes_(std::move(bytes)) {
+    }
+
+    size_t Size() const {
+        return bytes_.size();
+    }
+
+    uint8_t Get(size_t index) const {
+        return bytes_[index];
+    }
+
+    // See Vector::IsLiteral.
+    bool IsLiteral() const {
+        return header_extra_ != 0;
+    }
+
+    void MarkLiteral() {
+        header_extra_ = 1;
+    }
+
+    void Set(size_t index, uint8_t value) {
+        bytes_[index] = value;
+    }
+
+    std::string TakeStringValue() override {
+        std::string res = "#u8(";
+        for (size_t i = 0; i < bytes_.size(); ++i) {
+            if (i != 0) {
+                res.push_back(' ');
+            }
+            res += std::to_string(bytes_[i]);
+        }
+        res.push_back(')');
+        return res;
+    }
+
+    Object* Calculate() override {
+        return this;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+// Objects that evaluate to themselves.
+inline bool IsSelfEvaluating(const Object* obj) {
+    return Is<Number>(obj) || Is<Symbol>(obj) || Is<Vector>(obj) || Is<Bytevector>(obj);
+}
+
+// Most calls have only a few arguments; those are kept without a heap allocation.
+using Arguments = SmallVector<Object*, 4>;
+
+// Evaluates the elements of an argument list in order.
+Arguments TakeElem(Object* args_head);
+
+// Read-only view of evaluated arguments, wherever they are stored.
+class ArgumentsView {
+public:
+    ArgumentsView(const Arguments& args) : data_(args.begin()), size_(args.size()) {
+    }
+
+    ArgumentsView(Object* const* data, size_t size) : data_(data), size_(size) {
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    Object* operator[](size_t i) const {
+        return data_[i];
+    }
+
+    Object* const* begin() const {
+        return data_;
+    }
+
+    Object* const* end() const {
+        return data_ + size_;
+    }
+
+private:
+    Object* const* data_;
+    size_t size_;
+};
 
 template <class T>
-void TypeChecker(std::vector<std::shared_ptr<Object>> now_list);
+void TypeChecker(ArgumentsView now_list);
+
+// Evaluates expr, which has to be there and be resolved, at the top level on a
+// TreeWalker of its own. This is how the constant folder runs calls over constants.
+Object* Evaluate(Object* expr);
+
+class Compiler;
+class Resolver;
+class TreeWalker;
+class Cell;
+
+// What the constant folder may do with a call, see fold.h.
+enum class Folding {
+    NEVER,      // leave the call and everything in it alone
+    CONSTANT,   // the call stands for data, such as its unevaluated arguments
+    ARGUMENTS,  // the arguments are expressions, but the call has effects
+    PURE,       // arguments are evaluated, and constant ones give a constant result
+};
 
 class Function : public Object {
 public:
+    static constexpr ObjectType kType = ObjectType::FUNCTION;
+
+    Function() : Object(kType) {
+    }
+
     virtual ~Function() = default;
-    virtual std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) = 0;
+
+    // Has the tree walker leave the value of the call on its stack.
+    virtual void Walk(TreeWalker* walker, Cell* call) = 0;
+
+    // Emits bytecode that leaves the value of the call on the stack.
+    virtual void Compile(Compiler* compiler, Cell* call) = 0;
+
+    // Returns the call with its variables resolved. By default every argument
+    // is an expression.
+    virtual Object* Resolve(Resolver* resolver, Cell* call);
+
+    virtual Folding GetFolding() const {
+        return Folding::NEVER;
+    }
+};
+
+// A builtin that only needs the values of its arguments, evaluated left to right.
+class StrictFunction : public Function {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+
+    Folding GetFolding() const override {
+        return Folding::PURE;
+    }
+
+    virtual Object* Call(ArgumentsView elems) = 0;
+
+    // Fixed-arity entry points: short calls need no argument list at all.
+    // The arithmetic and comparison builtins override them, the rest fall back to Call.
+    virtual Object* Call1(Object* first) {
+        return Call(ArgumentsView(&first, 1));
+    }
+
+    virtual Object* Call2(Object* first, Object* second) {
+        Object* elems[] = {first, second};
+        return Call(ArgumentsView(elems, 2));
+    }
+
+    virtual Object* Call3(Object* first, Object* second, Object* third) {
+        Object* elems[] = {first, second, third};
+        return Call(ArgumentsView(elems, 3));
+    }
+
+    // Picks the entry point for the number of arguments.
+    Object* CallWith(ArgumentsView elems) {
+        switch (elems.size()) {
+            case 1:
+                return Call1(elems[0]);
+            case 2:
+                return Call2(elems[0], elems[1]);
+            case 3:
+                return Call3(elems[0], elems[1], elems[2]);
+            default:
+                return Call(elems);
+        }
+    }
+
+    // Some builtins reject argument lists by their form rather than by their values.
+    virtual bool AcceptsShape(Object*) const {
+        return true;
+    }
 };
 
-class IsNumber : public Function {
+class IsNumber : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Equality : public Function {
+class Equality : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class SignMore : public Function {
+class SignMore : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class SignLess : public Function {
+class SignLess : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class SignME : public Function {
+class SignME : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class SignLE : public Function {
+class SignLE : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class Plus : public Function {
+class Plus : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
+    bool AcceptsShape(Object* args_head) const override;
 };
 
-class Minus : public Function {
+class Minus : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class Multiplication : public Function {
+class Multiplication : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
+    Object* Call1(Object* first) override;
+    Object* Call2(Object* first, Object* second) override;
+    Object* Call3(Object* first, Object* second, Object* third) override;
 };
 
-class Devided : public Function {
+class Devided : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Maximum : public Function {
+class Maximum : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Modul : public Function {
+class Modul : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Minimum : public Function {
+class Minimum : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
 class Quote : public Function {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+
+    Folding GetFolding() const override {
+        return Folding::CONSTANT;
+    }
 };
 
-class IsBool : public Function {
+class IsBool : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Not : public Function {
+class Not : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class And : public Function {
+// A special form that evaluates only some of its arguments, chosen by the
+// values of others. The one that gives the value of the call is in tail
+// position. Resolve rejects malformed calls with SyntaxError. On the tree
+// walker, Walk evaluates the first argument the form needs, and Continue gets
+// its value with the rest Walk passed along and goes on from there.
+class ConditionalForm : public Function {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    virtual void Continue(TreeWalker* walker, Object* rest, Object* value) = 0;
+
+    Folding GetFolding() const override {
+        return Folding::PURE;
+    }
+};
+
+class And : public ConditionalForm {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
 };
 
-class Or : public Function {
+class Or : public ConditionalForm {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
 };
 
-class IsNull : public Function {
+// (if test consequent [alternative]); without the alternative a false test
+// gives the empty list, as do cond, when and unless when nothing is chosen.
+class If : public ConditionalForm {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+};
+
+// (cond (test body...) ... [(else body...)]); a clause without a body gives
+// the value of its test.
+class Cond : public ConditionalForm {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+
+    // The clauses are not expressions.
+    Folding GetFolding() const override {
+        return Folding::NEVER;
+    }
+
+    static bool IsElse(Object* test);
+};
+
+class When : public ConditionalForm {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+};
+
+class Unless : public ConditionalForm {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Continue(TreeWalker* walker, Object* rest, Object* value) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+};
+
+class IsNull : public StrictFunction {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
 class Liist : public Function {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+
+    Folding GetFolding() const override {
+        return Folding::CONSTANT;
+    }
+};
+
+class ListRef : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class ListTail : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
 };
 
-class ListRef : public Function {
+class Car : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class ListTail : public Function {
+class Cdr : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Car : public Function {
+class Cons : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Cdr : public Function {
+class Papair : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Cons : public Function {
+class IsList : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
-class Papair : public Function {
+// A strict builtin whose calls the constant folder must keep, because it
+// modifies its arguments or returns a fresh object that may be modified later.
+class ImpureFunction : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Folding GetFolding() const override {
+        return Folding::ARGUMENTS;
+    }
 };
 
-class IsList : public Function {
+class IsVector : public StrictFunction {
 public:
-    std::shared_ptr<Object> Apply(const std::shared_ptr<Object>& args_head) override;
+    Object* Call(ArgumentsView elems) override;
 };
 
+class VectorOf : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class NewVector : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class VectorLength : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class VectorRef : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class VectorSet : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class VectorFill : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class IsBytevector : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class BytevectorOf : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class NewBytevector : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class BytevectorLength : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class BytevectorRef : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class BytevectorSet : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class NewHashTable : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+// (hash-table-ref table key [default]) throws RuntimeError for a missing key
+// without a default.
+class HashTableRef : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class HashTableSet : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class HashTableDelete : public ImpureFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+class HashTableCount : public StrictFunction {
+public:
+    Object* Call(ArgumentsView elems) override;
+};
+
+// The binding forms are resolved away, see Resolver: lambda and let become a
+// Lambda and a call of one, and the name in define and set! a LocalRef or a
+// GlobalRef. Unresolved lambda and let calls fail when they are evaluated.
+class LambdaForm : public Function {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+};
+
+class LetForm : public Function {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+};
+
+class DefineForm : public Function {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+
+    // Once resolved, the variable and the value.
+    Folding GetFolding() const override {
+        return Folding::ARGUMENTS;
+    }
+};
+
+class SetForm : public Function {
+public:
+    void Walk(TreeWalker* walker, Cell* call) override;
+    void Compile(Compiler* compiler, Cell* call) override;
+    Object* Resolve(Resolver* resolver, Cell* call) override;
+
+    // Once resolved, the variable and the value.
+    Folding GetFolding() const override {
+        return Folding::ARGUMENTS;
+    }
+};
+
+Function* FindBuiltin(SymbolId id);
+
+// Builds the list of elements ending in tail, or nullptr if there are none,
+// out of contiguous runs of cells.
+Object* MakeList(ArgumentsView elements, Object* tail = nullptr);
+
+// Follows count cdrs from list, a run at a time. Throws RuntimeError if the
+// chain ends before that.
+Object* DropCells(Object* list, size_t count);
+
+// The builtin a call with this head refers to, or nullptr if there is none.
+inline Function* FindFunction(Object* head) {
+    if (Is<Symbol>(head)) {
+        return FindBuiltin(As<Symbol>(head)->GetId());
+    }
+    if (Is<SymbolQuote>(head)) {
+        return FindBuiltin(kQuoteMarkSymbol);
+    }
+    return nullptr;
+}
+
 class Cell : public Object {
 public:
-    std::shared_ptr<Object> first_;
-    std::shared_ptr<Object> second_;
-    std::map<std::string, std::shared_ptr<Function>> list_of_func;
-
-    Cell() {
-        first_ = nullptr;
-        second_ = nullptr;
-        list_of_func["number?"] = std::shared_ptr<Function>(new IsNumber());
-        list_of_func["="] = std::shared_ptr<Function>(new Equality());
-        list_of_func[">"] = std::shared_ptr<Function>(new SignMore());
-        list_of_func["<"] = std::shared_ptr<Function>(new SignLess());
-        list_of_func[">="] = std::shared_ptr<Function>(new SignME());
-        list_of_func["<="] = std::shared_ptr<Function>(new SignLE());
-        list_of_func["+"] = std::shared_ptr<Function>(new Plus());
-        list_of_func["-"] = std::shared_ptr<Function>(new Minus());
-        list_of_func["*"] = std::shared_ptr<Function>(new Multiplication());
-        list_of_func["/"] = std::shared_ptr<Function>(new Devided());
-        list_of_func["max"] = std::shared_ptr<Function>(new Maximum());
-        list_of_func["min"] = std::shared_ptr<Function>(new Minimum());
-        list_of_func["abs"] = std::shared_ptr<Function>(new Modul());
-        list_of_func["'"] = std::shared_ptr<Function>(new Quote());
-        list_of_func["quote"] = std::shared_ptr<Function>(new Quote());
-        list_of_func["boolean?"] = std::shared_ptr<Function>(new IsBool());
-        list_of_func["not"] = std::shared_ptr<Function>(new Not());
-        list_of_func["and"] = std::shared_ptr<Function>(new And());
-        list_of_func["or"] = std::shared_ptr<Function>(new Or());
-        list_of_func["null?"] = std::shared_ptr<Function>(new IsNull());
-        list_of_func["list"] = std::shared_ptr<Function>(new Liist());
-        list_of_func["list-ref"] = std::shared_ptr<Function>(new ListRef());
-        list_of_func["list-tail"] = std::shared_ptr<Function>(new ListTail());
-        list_of_func["car"] = std::shared_ptr<Function>(new Car());
-        list_of_func["cdr"] = std::shared_ptr<Function>(new Cdr());
-        list_of_func["cons"] = std::shared_ptr<Function>(new Cons());
-        list_of_func["pair?"] = std::shared_ptr<Function>(new Papair());
-        list_of_func["list?"] = std::shared_ptr<Function>(new IsList());
-    }
-
-    std::shared_ptr<Object> GetFirst() const {
+    static constexpr ObjectType kType = ObjectType::CELL;
+
+    // Longest run of cells MakeList lays out next to each other.
+    static constexpr size_t kMaxRun = UINT16_MAX;
+
+    Object* first_ = nullptr;
+    Object* second_ = nullptr;
+
+    Cell() : Object(kType) {
+        header_extra_ = 1;
+    }
+
+    // Number of cells, starting with this one, that lie next to each other
+    // in memory and are chained through second_. Lists from MakeList are
+    // made of such runs, so indexing into them skips a whole run at a time.
+    // Nothing changes second_ after a list has been built, which keeps the
+    // runs valid.
+    size_t GetRun() const {
+        return header_extra_;
+    }
+
+    // The cell count positions down the run; count must be below GetRun().
+    Cell* Advance(size_t count) {
+        return this + count;
+    }
+
+    friend Object* MakeList(ArgumentsView elements, Object* tail);
+
+    void Trace(std::vector<Object*>* out) override {
+        out->push_back(first_);
+        out->push_back(second_);
+    }
+
+    Object* GetFirst() const {
         return first_;
     }
-    std::shared_ptr<Object> GetSecond() const {
+    Object* GetSecond() const {
         return second_;
     }
 
-    std::string Inside() override {
-        std::string str;
-        if (first_ == nullptr && second_ == nullptr) {
-            str = "()";
-            return str;
-        }
-        if (Is<Cell>(first_)) {
-            str += first_->Inside();
-        } else {
-            if (first_ == nullptr) {
-                str += "()";
-            } else {
-                str += first_->TakeStringValue();
-            }
+    // See Print.
+    std::string TakeStringValue() override;
+
+    Object* Calculate() override {
+        return Evaluate(this);
+    }
+};
+
+// The local variables of one call of a Lambda, in the slots the resolver gave
+// them, and the frame the Lambda was evaluated in.
+class Frame : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::FRAME;
+
+    // All slots start out without a value.
+    Frame(Frame* parent, size_t size) : Object(kType), parent_(parent) {
+        slots_.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            slots_.push_back(nullptr);
         }
-        if (second_ != nullptr) {
-            if (Is<Cell>(second_)) {
-                if (!(As<Cell>(second_)->first_ == nullptr &&
-                      As<Cell>(second_)->second_ == nullptr)) {
-                    str += " ";
-                    str += second_->Inside();
-                }
-            } else {
-                str += " . ";
-                str += second_->TakeStringValue();
-            }
+    }
+
+    // The frame depth levels out from this one.
+    Frame* Up(size_t depth) {
+        Frame* frame = this;
+        for (; depth > 0; --depth) {
+            frame = frame->parent_;
         }
-        return str;
+        return frame;
+    }
+
+    Object*& Slot(size_t index) {
+        return slots_[index];
+    }
+
+    void Trace(std::vector<Object*>* out) override {
+        out->push_back(parent_);
+        out->insert(out->end(), slots_.begin(), slots_.end());
+    }
+
+private:
+    Frame* parent_;
+    SmallVector<Object*, 4> slots_;
+};
+
+// A local variable: the slot of the frame depth levels out from the current one.
+class LocalRef : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::LOCAL_REF;
+
+    LocalRef(SymbolId name, uint32_t depth, uint32_t slot)
+        : Object(kType), name_(name), depth_(depth), slot_(slot) {
+    }
+
+    SymbolId GetName() const {
+        return name_;
+    }
+
+    uint32_t GetDepth() const {
+        return depth_;
+    }
+
+    uint32_t GetSlot() const {
+        return slot_;
+    }
+
+    Object*& Locate(Frame* frame) const {
+        return frame->Up(depth_)->Slot(slot_);
     }
 
     std::string TakeStringValue() override {
-        std::string res;
-        res.push_back('(');
-        res += Inside();
-        res.push_back(')');
-        return res;
+        return SymbolName(name_);
     }
 
-    std::shared_ptr<Object> Calculate() override {
-        if (first_ == nullptr) {
-            throw RuntimeError("");
-        }
-        if (list_of_func.find(first_->TakeStringValue()) == list_of_func.end()) {
-            throw RuntimeError("");
-        }
-        return list_of_func[first_->TakeStringValue()]->Apply(second_);  // ...
+private:
+    SymbolId name_;
+    uint32_t depth_;
+    uint32_t slot_;
+};
+
+// A top-level variable, see GlobalEnvironment. value stays nullptr until the
+// variable is defined.
+struct GlobalVariable {
+    SymbolId name;
+    Object* value = nullptr;
+};
+
+class GlobalRef : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::GLOBAL_REF;
+
+    explicit GlobalRef(GlobalVariable* variable) : Object(kType), variable_(variable) {
+    }
+
+    GlobalVariable* GetVariable() const {
+        return variable_;
     }
+
+    std::string TakeStringValue() override {
+        return SymbolName(variable_->name);
+    }
+
+private:
+    GlobalVariable* variable_;
+};
+
+// The name of a LocalRef or a GlobalRef.
+inline SymbolId GetVariableName(Object* variable) {
+    if (Is<LocalRef>(variable)) {
+        return As<LocalRef>(variable)->GetName();
+    }
+    return As<GlobalRef>(variable)->GetVariable()->name;
+}
+
+// A resolved lambda expression. Its parameters take the first slots of its
+// frame, a rest parameter the one after them, and the variables defined in
+// its body the remaining ones. The virtual machine makes a Closure of it over
+// the current frame.
+class Lambda : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::LAMBDA;
+
+    Lambda(size_t arity, bool variadic, size_t frame_size, Object* body)
+        : Object(kType), arity_(arity), variadic_(variadic), frame_size_(frame_size), body_(body) {
+    }
+
+    // Makes the frame of a call with args. Throws RuntimeError if their
+    // number does not fit the parameters.
+    Frame* MakeFrame(Frame* parent, ArgumentsView args);
+
+    // The body compiled for the virtual machine, on first use.
+    const Code& GetCode();
+
+    Object* GetBody() const {
+        return body_;
+    }
+
+    void Trace(std::vector<Object*>* out) override {
+        out->push_back(body_);
+    }
+
+    std::string TakeStringValue() override {
+        return "#<lambda>";
+    }
+
+private:
+    size_t arity_;
+    bool variadic_;
+    size_t frame_size_;
+    // Proper list of the resolved expressions of the body.
+    Object* body_;
+    std::optional<Code> code_;
+};
+
+class Closure : public Object {
+public:
+    static constexpr ObjectType kType = ObjectType::CLOSURE;
+
+    Closure(Lambda* lambda, Frame* env) : Object(kType), lambda_(lambda), env_(env) {
+    }
+
+    Lambda* GetLambda() const {
+        return lambda_;
+    }
+
+    Frame* GetEnv() const {
+        return env_;
+    }
+
+    void Trace(std::vector<Object*>* out) override {
+        out->push_back(lambda_);
+        out->push_back(env_);
+    }
+
+    std::string TakeStringValue() override {
+        return "#<procedure>";
+    }
+
+    Object* Calculate() override {
+        return this;
+    }
+
+private:
+    Lambda* lambda_;
+    Frame* env_;
 };
@@ -1,116 +1,175 @@
 #include "parser.h"
+#include "arithmetic.h"
+#include "builtins.h"
+#include "hash_table.h"
 #include "object.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <vector>
 
-std::shared_ptr<Object> ReadClone(Tokenizer* tokenizer) {
-    Token now_token = tokenizer->GetToken();
-    tokenizer->Next();
-    Token next_token = tokenizer->GetToken();
-    if (std::get_if<BracketToken>(&now_token)) {
-        if (*std::get_if<BracketToken>(&now_token) == BracketToken::OPEN) {
-            return ReadList(tokenizer);
+namespace {
+
+// An unfinished list, vector, bytevector or quote of the reader. The elements
+// of open lists and vectors are kept on one shared stack, each one's from
+// begin on, and only turned into an object by Close, when their number is
+// known and MakeList can lay them out next to each other.
+struct ReadFrame {
+    enum class Kind { LIST, VECTOR, BYTEVECTOR, QUOTE };
+    enum class State { ELEMENTS, AFTER_DOT, CLOSED };
+
+    Kind kind;
+    size_t begin = 0;
+    Object* tail = nullptr;
+    State state = State::ELEMENTS;
+
+    void Add(Object* element, std::vector<Object*>* elements) {
+        if (Is<SymbolDot>(element)) {
+            if (kind != Kind::LIST || elements->size() == begin || state != State::ELEMENTS) {
+                throw SyntaxError("");
+            }
+            state = State::AFTER_DOT;
+        } else if (state == State::AFTER_DOT) {
+            tail = element;
+            state = State::CLOSED;
+        } else if (state == State::CLOSED) {
+            throw SyntaxError("");
         } else {
-            return std::shared_ptr<Object>(
-                new SymbolBracket(*std::get_if<BracketToken>(&now_token)));
+            elements->push_back(element);
         }
-    } else if (std::get_if<ConstantToken>(&now_token)) {
-        return std::shared_ptr<Object>(new Number(*std::get_if<ConstantToken>(&now_token)));
-    } else if (std::get_if<QuoteToken>(&now_token)) {
-        if (tokenizer->IsEnd()) {
-            return std::shared_ptr<Object>(new SymbolQuote(*std::get_if<QuoteToken>(&now_token)));
-        } else {
-            std::shared_ptr<Cell> raduga(new Cell);
-            raduga->first_ =
-                std::shared_ptr<Object>(new SymbolQuote(*std::get_if<QuoteToken>(&now_token)));
-            raduga->second_ = ReadClone(tokenizer);
-            return raduga;
+    }
+
+    Object* Close(std::vector<Object*>* elements) {
+        if (state == State::AFTER_DOT) {
+            throw SyntaxError("");
         }
-    } else if (std::get_if<DotToken>(&now_token)) {
-        if (std::get_if<BracketToken>(&next_token)) {
-            if (*std::get_if<BracketToken>(&next_token) == BracketToken::OPEN) {
-                return ReadClone(tokenizer);
+        ArgumentsView view(elements->data() + begin, elements->size() - begin);
+        Object* res;
+        if (kind == Kind::VECTOR) {
+            Vector* vector = Make<Vector>(std::vector<Object*>(view.begin(), view.end()));
+            vector->MarkLiteral();
+            res = vector;
+        } else if (kind == Kind::BYTEVECTOR) {
+            std::vector<uint8_t> bytes;
+            bytes.reserve(view.size());
+            for (Object* element : view) {
+                Number* number = As<Number>(element);
+                if (number == nullptr || !number->IsSmall() || number->GetValue() < 0 ||
+                    number->GetValue() > UINT8_MAX) {
+                    throw SyntaxError("");
+                }
+                bytes.push_back(number->GetValue());
             }
+            Bytevector* bytevector = Make<Bytevector>(std::move(bytes));
+            bytevector->MarkLiteral();
+            res = bytevector;
+        } else {
+            res = MakeList(view, tail);
         }
-        return std::shared_ptr<Object>(new SymbolDot(*std::get_if<DotToken>(&now_token)));
-    } else {
-        return std::shared_ptr<Object>(new Symbol(now_token));
+        elements->resize(begin);
+        return res;
+    }
+};
+
+// What an opening bracket starts.
+ReadFrame::Kind OpenedKind(BracketToken bracket) {
+    switch (bracket) {
+        case BracketToken::OPEN_VECTOR:
+            return ReadFrame::Kind::VECTOR;
+        case BracketToken::OPEN_BYTEVECTOR:
+            return ReadFrame::Kind::BYTEVECTOR;
+        default:
+            return ReadFrame::Kind::LIST;
     }
 }
 
-std::shared_ptr<Object> ReadList(Tokenizer* tokenizer) {
-    std::vector<std::shared_ptr<Object>> v;
-    std::shared_ptr<Object> now_object = nullptr;
+// Reads datums with an explicit stack of open lists and quotes instead of
+// recursion, so the native stack use does not depend on the nesting depth.
+Object* ReadWithStack(Tokenizer* tokenizer, std::vector<ReadFrame>* stack, size_t max_depth) {
+    std::vector<Object*> elements;
     while (true) {
         if (tokenizer->IsEnd()) {
             throw SyntaxError("");
         }
-        now_object = ReadClone(tokenizer);
-        if (Is<SymbolBracket>(now_object)) {
-            break;
-        } else {
-            v.push_back(now_object);
-        }
-    }
-    if (v.empty()) {
-        return nullptr;
-    }
-    if (v.size() == 1) {
-        if (!Is<SymbolDot>(v[0])) {
-            std::shared_ptr<Cell> res(new Cell);
-            res->first_ = v[0];
-            res->second_ = nullptr;
-            return res;
+        Token now_token = tokenizer->GetToken();
+        tokenizer->Next();
+        Object* datum;
+        if (const BracketToken* bracket = std::get_if<BracketToken>(&now_token)) {
+            if (*bracket != BracketToken::CLOSE) {
+                if (stack->size() >= max_depth) {
+                    throw SyntaxError("");
+                }
+                stack->push_back(ReadFrame{OpenedKind(*bracket), elements.size()});
+                continue;
+            }
+            if (!stack->empty() && stack->back().kind != ReadFrame::Kind::QUOTE) {
+                datum = stack->back().Close(&elements);
+                stack->pop_back();
+            } else {
+                datum = Make<SymbolBracket>(*bracket);
+            }
+        } else if (const ConstantToken* constant = std::get_if<ConstantToken>(&now_token)) {
+            datum = MakeNumber(*constant);
+        } else if (const QuoteToken* quote = std::get_if<QuoteToken>(&now_token)) {
+            if (tokenizer->IsEnd()) {
+                datum = Make<SymbolQuote>(*quote);
+            } else {
+                if (stack->size() >= max_depth) {
+                    throw SyntaxError("");
+                }
+                stack->push_back(ReadFrame{ReadFrame::Kind::QUOTE, elements.size()});
+                continue;
+            }
+        } else if (const DotToken* dot = std::get_if<DotToken>(&now_token)) {
+            // A dot right before a list is dropped and the list is read in its place.
+            Token next_token = tokenizer->GetToken();
+            if (!tokenizer->IsEnd() && std::get_if<BracketToken>(&next_token) &&
+                *std::get_if<BracketToken>(&next_token) == BracketToken::OPEN) {
+                continue;
+            }
+            datum = Make<SymbolDot>(*dot);
         } else {
-            throw SyntaxError("");
+            datum = MakeSymbol(std::get<SymbolToken>(now_token).id);
         }
-    }
-    if (v.size() == 2) {
-        if (!Is<SymbolDot>(v[0]) && !Is<SymbolDot>(v[1])) {
-            std::shared_ptr<Cell> res_btw(new Cell);
-            res_btw->first_ = v[1];
-            res_btw->second_ = nullptr;
-            std::shared_ptr<Cell> res(new Cell);
-            res->first_ = v[0];
-            res->second_ = res_btw;
-            return res;
-        } else {
-            throw SyntaxError("");
+
+        while (!stack->empty() && stack->back().kind == ReadFrame::Kind::QUOTE) {
+            Cell* raduga = Make<Cell>();
+            raduga->first_ = Make<SymbolQuote>(QuoteToken{});
+            raduga->second_ = datum;
+            datum = raduga;
+            stack->pop_back();
         }
-    }
-    int sz = v.size();
-    for (int i = 0; i < sz; ++i) {
-        if (Is<SymbolDot>(v[i]) && i != sz - 2) {
-            throw SyntaxError("");
+        if (stack->empty()) {
+            return datum;
         }
+        stack->back().Add(datum, &elements);
     }
-    int index = sz - 1;
-    std::shared_ptr<Cell> last(new Cell);
-    if (Is<SymbolDot>(v[sz - 2])) {
-        last->second_ = v[sz - 1];
-        last->first_ = v[sz - 3];
-        index = sz - 4;
-    } else {
-        last = nullptr;
-    }
-    for (int i = index; i >= 0; --i) {
-        std::shared_ptr<Cell> new_last(new Cell);
-        new_last->second_ = last;
-        new_last->first_ = v[i];
-        last = new_last;
-    }
-    return last;
 }
 
-std::shared_ptr<Object> Read(Tokenizer* tokenizer) {
+}  // namespace
+
+Object* ReadList(Tokenizer* tokenizer, size_t max_depth) {
+    std::vector<ReadFrame> stack{ReadFrame{ReadFrame::Kind::LIST}};
+    return ReadWithStack(tokenizer, &stack, max_depth);
+}
+
+Object* ReadDatum(Tokenizer* tokenizer, size_t max_depth) {
     if (tokenizer->IsEnd()) {
         throw SyntaxError("");
     }
-    std::shared_ptr<Object> res = ReadClone(tokenizer);
-    if (!tokenizer->IsEnd()) {
+    std::vector<ReadFrame> stack;
+    Object* res = ReadWithStack(tokenizer, &stack, max_depth);
+    if (Is<SymbolQuote>(res)) {
         throw SyntaxError("");
     }
-    if (Is<SymbolQuote>(res)) {
+    return res;
+}
+
+Object* Read(Tokenizer* tokenizer, size_t max_depth) {
+    Object* res = ReadDatum(tokenizer, max_depth);
+    if (!tokenizer->IsEnd()) {
         throw SyntaxError("");
     }
     return res;
@@ -119,7 +178,7 @@ std::shared_ptr<Object> Read(Tokenizer* tokenizer) {
 // KOMMEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEEENT
 
 template <class T>
-void TypeChecker(std::vector<std::shared_ptr<Object>> now_list) {
+void TypeChecker(ArgumentsView now_list) {
     for (size_t i = 0; i < now_list.size(); ++i) {
         if (!Is<T>(now_list[i])) {
             throw RuntimeError("");
@@ -127,424 +186,820 @@ void TypeChecker(std::vector<std::shared_ptr<Object>> now_list) {
     }
 }
 
-std::vector<std::shared_ptr<Object>> TakeElem(std::shared_ptr<Object> args_head) {
-    std::vector<std::shared_ptr<Object>> res;
-    if (args_head == nullptr) {
-        return res;
-    }
-    if (Is<Cell>(args_head)) {
-        std::shared_ptr<Cell> now_cell = As<Cell>(args_head);
+Arguments TakeElem(Object* args_head) {
+    Arguments res;
+    while (args_head != nullptr) {
+        if (!Is<Cell>(args_head)) {
+            res.push_back(args_head);
+            break;
+        }
+        Cell* now_cell = As<Cell>(args_head);
         if (now_cell->first_ == nullptr && now_cell->second_ == nullptr) {
-            return res;
+            break;
         }
         if (now_cell->first_ != nullptr) {
             res.push_back(now_cell->first_->Calculate());
         }
-        if (now_cell->second_ == nullptr) {
-            return res;
+        args_head = now_cell->second_;
+    }
+    return res;
+}
+
+Object* MakeList(ArgumentsView elements, Object* tail) {
+    Object* head = tail;
+    // Built back to front, so each run can point at the one after it.
+    for (size_t end = elements.size(); end > 0;) {
+        size_t run = std::min(end, Cell::kMaxRun);
+        Cell* cells = MakeRun<Cell>(run);
+        for (size_t i = 0; i < run; ++i) {
+            Cell* cell = cells->Advance(i);
+            cell->first_ = elements[end - run + i];
+            cell->second_ = i + 1 < run ? cells->Advance(i + 1) : head;
+            cell->header_extra_ = run - i;
         }
+        head = cells;
+        end -= run;
+    }
+    return head;
+}
 
-        std::vector<std::shared_ptr<Object>> dop_res = TakeElem(now_cell->second_);
-        for (auto i : dop_res) {
-            res.push_back(i);
+Object* DropCells(Object* list, size_t count) {
+    while (count > 0) {
+        Cell* cell = As<Cell>(list);
+        if (cell == nullptr) {
+            throw RuntimeError("");
         }
-    } else {
-        res.push_back(args_head);
+        if (count < cell->GetRun()) {
+            return cell->Advance(count);
+        }
+        count -= cell->GetRun();
+        list = cell->Advance(cell->GetRun() - 1)->second_;
     }
-    return res;
+    return list;
+}
+
+namespace {
+
+Number* ToNumber(Object* obj) {
+    Number* number = As<Number>(obj);
+    if (number == nullptr) {
+        throw RuntimeError("");
+    }
+    return number;
+}
+
+// order is applied to the result of Compare and zero. Every order is false
+// when a NaN is involved.
+template <class Order>
+bool InOrder(Number* first, Number* second, Order order) {
+    return !IsUnordered(first, second) && order(Compare(first, second), 0);
+}
+
+// Like the variadic comparisons, every argument is type checked before any is
+// compared.
+template <class Order>
+Object* CompareNumbers(Object* first, Object* second, Order order) {
+    Number* first_number = ToNumber(first);
+    Number* second_number = ToNumber(second);
+    return MakeBool(InOrder(first_number, second_number, order));
 }
 
-std::shared_ptr<Object> IsNumber::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+template <class Order>
+Object* CompareNumbers(Object* first, Object* second, Object* third, Order order) {
+    Number* first_number = ToNumber(first);
+    Number* second_number = ToNumber(second);
+    Number* third_number = ToNumber(third);
+    return MakeBool(InOrder(first_number, second_number, order) &&
+                    InOrder(second_number, third_number, order));
+}
+
+Vector* ToVector(Object* obj) {
+    Vector* vector = As<Vector>(obj);
+    if (vector == nullptr) {
+        throw RuntimeError("");
+    }
+    return vector;
+}
+
+HashTable* ToHashTable(Object* obj) {
+    HashTable* table = As<HashTable>(obj);
+    if (table == nullptr) {
+        throw RuntimeError("");
+    }
+    return table;
+}
+
+Bytevector* ToBytevector(Object* obj) {
+    Bytevector* bytevector = As<Bytevector>(obj);
+    if (bytevector == nullptr) {
+        throw RuntimeError("");
+    }
+    return bytevector;
+}
+
+// A vector or bytevector that may be changed, which literals may not.
+template <class T>
+T* ToMutable(T* object) {
+    if (object->IsLiteral()) {
+        throw RuntimeError("");
+    }
+    return object;
+}
+
+// A length for a new vector or bytevector.
+size_t ToLength(Object* obj) {
+    Number* number = ToNumber(obj);
+    if (!number->IsSmall() || number->GetValue() < 0) {
+        throw RuntimeError("");
+    }
+    return number->GetValue();
+}
+
+// An index into something with size elements.
+size_t ToIndex(Object* obj, size_t size) {
+    size_t index = ToLength(obj);
+    if (index >= size) {
+        throw RuntimeError("");
+    }
+    return index;
+}
+
+uint8_t ToByte(Object* obj) {
+    size_t byte = ToLength(obj);
+    if (byte > UINT8_MAX) {
+        throw RuntimeError("");
+    }
+    return byte;
+}
+
+}  // namespace
+
+Object* IsNumber::Call(ArgumentsView elems) {
     if (elems.size() != 1) {
         throw RuntimeError("");
     }
     if (Is<Number>(elems[0])) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
-    return std::make_shared<Symbol>("#f");
+    return False();
 }
 
-std::shared_ptr<Object> Equality::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Equality::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
     TypeChecker<Number>(elems);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems - 1; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        std::shared_ptr<Number> second_number = As<Number>(elems[i + 1]);
-        if (first_number->GetValue() != second_number->GetValue()) {
-            return std::make_shared<Symbol>("#f");
+        Number* first_number = As<Number>(elems[i]);
+        Number* second_number = As<Number>(elems[i + 1]);
+        if (!InOrder(first_number, second_number, std::equal_to<int>())) {
+            return False();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return True();
+}
+
+Object* Equality::Call1(Object* first) {
+    ToNumber(first);
+    return True();
+}
+
+Object* Equality::Call2(Object* first, Object* second) {
+    return CompareNumbers(first, second, std::equal_to<int>());
+}
+
+Object* Equality::Call3(Object* first, Object* second, Object* third) {
+    return CompareNumbers(first, second, third, std::equal_to<int>());
 }
 
-std::shared_ptr<Object> SignMore::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* SignMore::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
     TypeChecker<Number>(elems);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems - 1; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        std::shared_ptr<Number> second_number = As<Number>(elems[i + 1]);
-        if (first_number->GetValue() <= second_number->GetValue()) {
-            return std::make_shared<Symbol>("#f");
+        Number* first_number = As<Number>(elems[i]);
+        Number* second_number = As<Number>(elems[i + 1]);
+        if (!InOrder(first_number, second_number, std::greater<int>())) {
+            return False();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return True();
 }
 
-std::shared_ptr<Object> SignLess::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* SignMore::Call1(Object* first) {
+    ToNumber(first);
+    return True();
+}
+
+Object* SignMore::Call2(Object* first, Object* second) {
+    return CompareNumbers(first, second, std::greater<int>());
+}
+
+Object* SignMore::Call3(Object* first, Object* second, Object* third) {
+    return CompareNumbers(first, second, third, std::greater<int>());
+}
+
+Object* SignLess::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
     TypeChecker<Number>(elems);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems - 1; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        std::shared_ptr<Number> second_number = As<Number>(elems[i + 1]);
-        if (first_number->GetValue() >= second_number->GetValue()) {
-            return std::make_shared<Symbol>("#f");
+        Number* first_number = As<Number>(elems[i]);
+        Number* second_number = As<Number>(elems[i + 1]);
+        if (!InOrder(first_number, second_number, std::less<int>())) {
+            return False();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return True();
+}
+
+Object* SignLess::Call1(Object* first) {
+    ToNumber(first);
+    return True();
 }
 
-std::shared_ptr<Object> SignME::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* SignLess::Call2(Object* first, Object* second) {
+    return CompareNumbers(first, second, std::less<int>());
+}
+
+Object* SignLess::Call3(Object* first, Object* second, Object* third) {
+    return CompareNumbers(first, second, third, std::less<int>());
+}
+
+Object* SignME::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
     TypeChecker<Number>(elems);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems - 1; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        std::shared_ptr<Number> second_number = As<Number>(elems[i + 1]);
-        if (first_number->GetValue() < second_number->GetValue()) {
-            return std::make_shared<Symbol>("#f");
+        Number* first_number = As<Number>(elems[i]);
+        Number* second_number = As<Number>(elems[i + 1]);
+        if (!InOrder(first_number, second_number, std::greater_equal<int>())) {
+            return False();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return True();
+}
+
+Object* SignME::Call1(Object* first) {
+    ToNumber(first);
+    return True();
 }
 
-std::shared_ptr<Object> SignLE::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* SignME::Call2(Object* first, Object* second) {
+    return CompareNumbers(first, second, std::greater_equal<int>());
+}
+
+Object* SignME::Call3(Object* first, Object* second, Object* third) {
+    return CompareNumbers(first, second, third, std::greater_equal<int>());
+}
+
+Object* SignLE::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
-        return std::make_shared<Symbol>("#t");
+        return True();
     }
     TypeChecker<Number>(elems);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems - 1; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        std::shared_ptr<Number> second_number = As<Number>(elems[i + 1]);
-        if (first_number->GetValue() > second_number->GetValue()) {
-            return std::make_shared<Symbol>("#f");
+        Number* first_number = As<Number>(elems[i]);
+        Number* second_number = As<Number>(elems[i + 1]);
+        if (!InOrder(first_number, second_number, std::less_equal<int>())) {
+            return False();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return True();
 }
 
-std::shared_ptr<Object> Plus::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    TypeChecker<Number>(elems);
+Object* SignLE::Call1(Object* first) {
+    ToNumber(first);
+    return True();
+}
+
+Object* SignLE::Call2(Object* first, Object* second) {
+    return CompareNumbers(first, second, std::less_equal<int>());
+}
+
+Object* SignLE::Call3(Object* first, Object* second, Object* third) {
+    return CompareNumbers(first, second, third, std::less_equal<int>());
+}
+
+bool Plus::AcceptsShape(Object* args_head) const {
     if (Is<Cell>(args_head)) {
-        std::shared_ptr<Cell> burunduk = As<Cell>(args_head);
+        Cell* burunduk = As<Cell>(args_head);
         if (burunduk->first_ == nullptr && burunduk->second_ == nullptr) {
-            throw RuntimeError("");
+            return false;
         }
     }
-    int summa = 0;
-    int size_of_elems = elems.size();
-    for (int i = 0; i < size_of_elems; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        summa += first_number->GetValue();
-    }
-    return std::make_shared<Number>(summa);
+    return true;
+}
+
+Object* Plus::Call(ArgumentsView elems) {
+    TypeChecker<Number>(elems);
+    return Sum(elems);
+}
+
+Object* Plus::Call1(Object* first) {
+    ToNumber(first);
+    return first;
+}
+
+Object* Plus::Call2(Object* first, Object* second) {
+    return Add(ToNumber(first), ToNumber(second));
+}
+
+Object* Plus::Call3(Object* first, Object* second, Object* third) {
+    Number* first_number = ToNumber(first);
+    Number* second_number = ToNumber(second);
+    Number* third_number = ToNumber(third);
+    return Add(Add(first_number, second_number), third_number);
 }
 
-std::shared_ptr<Object> Minus::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Minus::Call(ArgumentsView elems) {
     if (elems.size() == 0) {
         throw RuntimeError("");
     }
     TypeChecker<Number>(elems);
-    int summa = As<Number>(elems[0])->GetValue();
+    Number* summa = As<Number>(elems[0]);
     int size_of_elems = elems.size();
     for (int i = 1; i < size_of_elems; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        summa -= first_number->GetValue();
+        Number* first_number = As<Number>(elems[i]);
+        summa = Subtract(summa, first_number);
     }
-    return std::make_shared<Number>(summa);
+    return summa;
+}
+
+Object* Minus::Call1(Object* first) {
+    ToNumber(first);
+    return first;
+}
+
+Object* Minus::Call2(Object* first, Object* second) {
+    return Subtract(ToNumber(first), ToNumber(second));
 }
 
-std::shared_ptr<Object> Multiplication::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Minus::Call3(Object* first, Object* second, Object* third) {
+    Number* first_number = ToNumber(first);
+    Number* second_number = ToNumber(second);
+    Number* third_number = ToNumber(third);
+    return Subtract(Subtract(first_number, second_number), third_number);
+}
+
+Object* Multiplication::Call(ArgumentsView elems) {
     TypeChecker<Number>(elems);
-    int summa = 1;
+    Number* summa = MakeNumber(1);
     int size_of_elems = elems.size();
     for (int i = 0; i < size_of_elems; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        summa *= first_number->GetValue();
+        Number* first_number = As<Number>(elems[i]);
+        summa = Multiply(summa, first_number);
     }
-    return std::make_shared<Number>(summa);
+    return summa;
+}
+
+Object* Multiplication::Call1(Object* first) {
+    ToNumber(first);
+    return first;
 }
 
-std::shared_ptr<Object> Devided::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Multiplication::Call2(Object* first, Object* second) {
+    return Multiply(ToNumber(first), ToNumber(second));
+}
+
+Object* Multiplication::Call3(Object* first, Object* second, Object* third) {
+    Number* first_number = ToNumber(first);
+    Number* second_number = ToNumber(second);
+    Number* third_number = ToNumber(third);
+    return Multiply(Multiply(first_number, second_number), third_number);
+}
+
+Object* Devided::Call(ArgumentsView elems) {
     TypeChecker<Number>(elems);
     if (elems.size() == 0) {
         throw RuntimeError("");
     }
-    int summa = As<Number>(elems[0])->GetValue();
+    Number* summa = As<Number>(elems[0]);
     int size_of_elems = elems.size();
     for (int i = 1; i < size_of_elems; ++i) {
-        std::shared_ptr<Number> first_number = As<Number>(elems[i]);
-        summa /= first_number->GetValue();
+        Number* first_number = As<Number>(elems[i]);
+        summa = Divide(summa, first_number);
     }
-    return std::make_shared<Number>(summa);
+    return summa;
 }
 
-std::shared_ptr<Object> Maximum::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Maximum::Call(ArgumentsView elems) {
     if (elems.size() < 1) {
         throw RuntimeError("");
     }
     TypeChecker<Number>(elems);
-    std::shared_ptr<Number> first_number = As<Number>(elems[0]);
-    int maxim = first_number->GetValue();
-    int size_of_elems = elems.size();
-    for (int i = 1; i < size_of_elems; ++i) {
-        maxim = std::max(As<Number>(elems[i])->GetValue(), maxim);
-    }
-    return std::make_shared<Number>(maxim);
+    return Max(elems);
 }
 
-std::shared_ptr<Object> Minimum::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Minimum::Call(ArgumentsView elems) {
     if (elems.size() < 1) {
         throw RuntimeError("");
     }
     TypeChecker<Number>(elems);
-    std::shared_ptr<Number> first_number = As<Number>(elems[0]);
-    int maxim = first_number->GetValue();
-    int size_of_elems = elems.size();
-    for (int i = 1; i < size_of_elems; ++i) {
-        maxim = std::min(As<Number>(elems[i])->GetValue(), maxim);
-    }
-    return std::make_shared<Number>(maxim);
+    return Min(elems);
 }
 
-std::shared_ptr<Object> Modul::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Modul::Call(ArgumentsView elems) {
     TypeChecker<Number>(elems);
     if (elems.size() != 1) {
         throw RuntimeError("");
     }
-    return std::make_shared<Number>(abs(As<Number>(elems[0])->GetValue()));
+    return Abs(As<Number>(elems[0]));
 }
 
-std::shared_ptr<Object> Quote::Apply(const std::shared_ptr<Object>& args_head) {
-    if (args_head == nullptr) {
-        return std::make_shared<Symbol>("()");
+Object* IsBool::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
+        throw RuntimeError("");
     }
-    return args_head;
+    return MakeBool(elems[0] == True() || elems[0] == False());
 }
 
-std::shared_ptr<Object> IsBool::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* Not::Call(ArgumentsView elems) {
     if (elems.size() != 1) {
         throw RuntimeError("");
     }
-    if (Is<Symbol>(elems[0])) {
-        if (elems[0]->TakeStringValue() == "#t" || elems[0]->TakeStringValue() == "#f") {
-            return std::make_shared<Symbol>("#t");
-        } else {
-            return std::make_shared<Symbol>("#f");
-        }
+    return MakeBool(!IsTruthy(elems[0]));
+}
+
+bool Cond::IsElse(Object* test) {
+    static const SymbolId kElse = Intern("else");
+    return Is<Symbol>(test) && As<Symbol>(test)->GetId() == kElse;
+}
+
+Object* IsNull::Call(ArgumentsView elems) {
+    Object* karakatica = elems[0];
+    if (karakatica == nullptr ||
+        (Is<Cell>(karakatica) && As<Cell>(karakatica)->first_ == nullptr &&
+         As<Cell>(karakatica)->second_ == nullptr) ||
+        karakatica == EmptyList()) {
+        return True();
     }
-    return std::make_shared<Symbol>("#f");
+    return False();
 }
 
-std::shared_ptr<Object> Not::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    if (elems.size() != 1) {
+Object* ListRef::Call(ArgumentsView elems) {
+    if (elems.size() < 2 || !Is<Number>(elems[1])) {
         throw RuntimeError("");
     }
-    if (Is<Symbol>(elems[0])) {
-        if (elems[0]->TakeStringValue() == "#t") {
-            return std::make_shared<Symbol>("#f");
-        } else if (elems[0]->TakeStringValue() == "#f") {
-            return std::make_shared<Symbol>("#t");
-        } else {
-            return std::make_shared<Symbol>("#f");
-        }
+    Number* index = As<Number>(elems[1]);
+    if (!index->IsSmall() || index->GetValue() < 0) {
+        throw RuntimeError("");
+    }
+    Cell* cell = As<Cell>(DropCells(elems[0], index->GetValue()));
+    if (cell == nullptr) {
+        throw RuntimeError("");
     }
-    return std::make_shared<Symbol>("#f");
+    if (cell->first_ == nullptr) {
+        return EmptyList();
+    }
+    return cell->first_;
 }
 
-std::shared_ptr<Object> And::Apply(const std::shared_ptr<Object>& args_head) {
-    if (args_head == nullptr) {
-        return std::make_shared<Symbol>("#t");
-    }
-    if (Is<Symbol>(args_head) && args_head->TakeStringValue() == "#f") {
-        return std::make_shared<Symbol>("#f");
+Object* ListTail::Call(ArgumentsView elems) {
+    if (elems.size() < 2 || !Is<Number>(elems[1])) {
+        throw RuntimeError("");
     }
-    if (As<Symbol>(args_head) || As<Number>(args_head)) {
-        return args_head;
+    Number* index = As<Number>(elems[1]);
+    if (!index->IsSmall() || index->GetValue() < 0) {
+        throw RuntimeError("");
     }
-    if (Is<Cell>(args_head)) {
-        std::shared_ptr<Cell> now_cell = As<Cell>(args_head);
-        if (now_cell->second_ == nullptr) {
-            return now_cell->first_->Calculate();
-        }
-        if (now_cell->first_->Calculate()->TakeStringValue() == "#f") {
-            return std::make_shared<Symbol>("#f");
-        } else {
-            return And::Apply(now_cell->second_);
-        }
+    Object* result = DropCells(elems[0], index->GetValue());
+    if (result == nullptr) {
+        return EmptyList();  // СОМНИТЕЛЬНЫЙ КОСТЫЛЬ!
     }
-    return std::make_shared<Symbol>("#t");
+    return result;
 }
 
-std::shared_ptr<Object> Or::Apply(const std::shared_ptr<Object>& args_head) {
-    if (args_head == nullptr) {
-        return std::make_shared<Symbol>("#f");
+Object* Car::Call(ArgumentsView elems) {
+    if (elems.empty() || elems[0] == nullptr || Is<Symbol>(elems[0])) {
+        throw RuntimeError("");
     }
-    if (Is<Symbol>(args_head) && args_head->TakeStringValue() == "#t") {
-        return std::make_shared<Symbol>("#t");
+    if (Is<Cell>(elems[0])) {
+        return As<Cell>(elems[0])->first_;
+    } else {
+        return elems[0];
     }
-    if (As<Symbol>(args_head) || As<Number>(args_head)) {
-        return args_head;
+}
+
+Object* Cdr::Call(ArgumentsView elems) {
+    if (elems.empty() || Is<Symbol>(elems[0])) {
+        throw RuntimeError("");
     }
-    if (Is<Cell>(args_head)) {
-        std::shared_ptr<Cell> now_cell = As<Cell>(args_head);
-        if (now_cell->second_ == nullptr) {
-            return now_cell->first_->Calculate();
-        }
-        if (now_cell->first_->Calculate()->TakeStringValue() == "#t") {
-            return std::make_shared<Symbol>("#t");
+    if (Is<Cell>(elems[0])) {
+        if (As<Cell>(elems[0])->second_ != nullptr) {
+            return As<Cell>(elems[0])->second_;
         } else {
-            return Or::Apply(now_cell->second_);
+            return EmptyList();
         }
     }
-    return std::make_shared<Symbol>("#t");
+    return EmptyList();
 }
 
-std::shared_ptr<Object> IsNull::Apply(const std::shared_ptr<Object>& args_head) {
-    if (!Is<Cell>(args_head)) {
+Object* Cons::Call(ArgumentsView elems) {
+    if (elems.size() != 2) {
         throw RuntimeError("");
     }
-    std::shared_ptr<Object> karakatica = As<Cell>(args_head)->first_->Calculate();
-    if (karakatica == nullptr ||
-        (Is<Cell>(karakatica) && As<Cell>(karakatica)->first_ == nullptr &&
-         As<Cell>(karakatica)->second_ == nullptr) ||
-        (Is<Symbol>(karakatica) && As<Symbol>(karakatica)->TakeStringValue() == "()")) {
-        return std::make_shared<Symbol>("#t");
+    Cell* result = Make<Cell>();
+    result->first_ = elems[0];
+    result->second_ = elems[1];
+    return result;
+}
+
+Object* Papair::Call(ArgumentsView elems) {
+    if (elems.empty()) {
+        throw RuntimeError("");
     }
-    return std::make_shared<Symbol>("#f");
+    // Only the cell itself is looked at, never the data in it. A cell without
+    // either part is the empty list, see IsNull.
+    Cell* cell = As<Cell>(elems[0]);
+    return MakeBool(cell != nullptr && (cell->first_ != nullptr || cell->second_ != nullptr));
 }
 
-std::shared_ptr<Object> Liist::Apply(const std::shared_ptr<Object>& args_head) {
-    if (args_head == nullptr) {
-        return std::make_shared<Symbol>("()");
+Object* IsList::Call(ArgumentsView elems) {
+    if (elems.empty()) {
+        throw RuntimeError("");
+    }
+    if (elems[0] == nullptr || elems[0] == EmptyList()) {
+        return True();
     }
-    return args_head;
+    Object* now_ob = elems[0];
+    while (Is<Cell>(now_ob)) {
+        Cell* now_cell = As<Cell>(now_ob);
+        now_ob = now_cell->Advance(now_cell->GetRun() - 1)->second_;
+    }
+    if (now_ob != nullptr) {
+        return False();
+    }
+    return True();
 }
 
-std::shared_ptr<Object> ListRef::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    std::vector<std::shared_ptr<Object>> in_elems = TakeElem(elems[0]);
-    size_t n = As<Number>(elems[1])->GetValue();
-    if (n >= in_elems.size()) {
+Object* IsVector::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
         throw RuntimeError("");
     }
-    return in_elems[n];
+    return MakeBool(Is<Vector>(elems[0]));
 }
 
-std::shared_ptr<Object> ListTail::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    std::vector<std::shared_ptr<Object>> in_elems = TakeElem(elems[0]);
-    size_t n = As<Number>(elems[1])->GetValue();
-    if (n > in_elems.size()) {
+Object* VectorOf::Call(ArgumentsView elems) {
+    return Make<Vector>(std::vector<Object*>(elems.begin(), elems.end()));
+}
+
+Object* NewVector::Call(ArgumentsView elems) {
+    if (elems.size() != 1 && elems.size() != 2) {
         throw RuntimeError("");
     }
-    size_t counter = 0;
-    std::shared_ptr<Object> result = elems[0];
-    while (counter != n) {
-        result = As<Cell>(result)->second_;
-        ++counter;
+    Object* fill = elems.size() == 2 ? elems[1] : MakeNumber(0);
+    return Make<Vector>(std::vector<Object*>(ToLength(elems[0]), fill));
+}
+
+Object* VectorLength::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
+        throw RuntimeError("");
     }
-    if (result == nullptr) {
-        return std::make_shared<Symbol>("()");  // СОМНИТЕЛЬНЫЙ КОСТЫЛЬ!
+    return MakeNumber(static_cast<int64_t>(ToVector(elems[0])->Size()));
+}
+
+Object* VectorRef::Call(ArgumentsView elems) {
+    if (elems.size() != 2) {
+        throw RuntimeError("");
     }
-    return result;
+    Vector* vector = ToVector(elems[0]);
+    return vector->Get(ToIndex(elems[1], vector->Size()));
 }
 
-std::shared_ptr<Object> Car::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    if (elems[0] == nullptr || Is<Symbol>(elems[0])) {
+Object* VectorSet::Call(ArgumentsView elems) {
+    if (elems.size() != 3) {
         throw RuntimeError("");
     }
-    if (Is<Cell>(elems[0])) {
-        return As<Cell>(elems[0])->first_;
-    } else {
-        return elems[0];
+    Vector* vector = ToMutable(ToVector(elems[0]));
+    vector->Set(ToIndex(elems[1], vector->Size()), elems[2]);
+    return vector;
+}
+
+Object* VectorFill::Call(ArgumentsView elems) {
+    if (elems.size() != 2) {
+        throw RuntimeError("");
     }
+    Vector* vector = ToMutable(ToVector(elems[0]));
+    vector->Fill(elems[1]);
+    return vector;
 }
 
-std::shared_ptr<Object> Cdr::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    if (args_head == nullptr || Is<Symbol>(elems[0])) {
+Object* IsBytevector::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
         throw RuntimeError("");
     }
-    if (Is<Cell>(elems[0])) {
-        if (As<Cell>(elems[0])->second_ != nullptr) {
-            return As<Cell>(elems[0])->second_;
-        } else {
-            return std::make_shared<Symbol>("()");
-        }
+    return MakeBool(Is<Bytevector>(elems[0]));
+}
+
+Object* BytevectorOf::Call(ArgumentsView elems) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(elems.size());
+    for (Object* element : elems) {
+        bytes.push_back(ToByte(element));
     }
-    return std::make_shared<Symbol>("()");
+    return Make<Bytevector>(std::move(bytes));
 }
 
-std::shared_ptr<Object> Cons::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
+Object* NewBytevector::Call(ArgumentsView elems) {
+    if (elems.size() != 1 && elems.size() != 2) {
+        throw RuntimeError("");
+    }
+    uint8_t fill = elems.size() == 2 ? ToByte(elems[1]) : 0;
+    return Make<Bytevector>(std::vector<uint8_t>(ToLength(elems[0]), fill));
+}
+
+Object* BytevectorLength::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
+        throw RuntimeError("");
+    }
+    return MakeNumber(static_cast<int64_t>(ToBytevector(elems[0])->Size()));
+}
+
+Object* BytevectorRef::Call(ArgumentsView elems) {
     if (elems.size() != 2) {
         throw RuntimeError("");
     }
-    std::shared_ptr<Cell> result = std::make_shared<Cell>(Cell());
-    result->first_ = elems[0];
-    result->second_ = elems[1];
-    return result;
+    Bytevector* bytevector = ToBytevector(elems[0]);
+    return MakeNumber(bytevector->Get(ToIndex(elems[1], bytevector->Size())));
 }
 
-std::shared_ptr<Object> Papair::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    elems = TakeElem(elems[0]);
+Object* BytevectorSet::Call(ArgumentsView elems) {
+    if (elems.size() != 3) {
+        throw RuntimeError("");
+    }
+    Bytevector* bytevector = ToMutable(ToBytevector(elems[0]));
+    bytevector->Set(ToIndex(elems[1], bytevector->Size()), ToByte(elems[2]));
+    return bytevector;
+}
+
+Object* NewHashTable::Call(ArgumentsView elems) {
+    if (elems.size() != 0) {
+        throw RuntimeError("");
+    }
+    return Make<HashTable>();
+}
+
+Object* HashTableRef::Call(ArgumentsView elems) {
+    if (elems.size() != 2 && elems.size() != 3) {
+        throw RuntimeError("");
+    }
+    Object* value = ToHashTable(elems[0])->Find(elems[1]);
+    if (value != nullptr) {
+        return value;
+    }
+    if (elems.size() == 2) {
+        throw RuntimeError("");
+    }
+    return elems[2];
+}
+
+Object* HashTableSet::Call(ArgumentsView elems) {
+    if (elems.size() != 3) {
+        throw RuntimeError("");
+    }
+    HashTable* table = ToHashTable(elems[0]);
+    table->Insert(elems[1], elems[2]);
+    return table;
+}
+
+Object* HashTableDelete::Call(ArgumentsView elems) {
     if (elems.size() != 2) {
-        return std::make_shared<Symbol>("#f");
+        throw RuntimeError("");
     }
-    return std::make_shared<Symbol>("#t");
+    HashTable* table = ToHashTable(elems[0]);
+    table->Erase(elems[1]);
+    return table;
 }
 
-std::shared_ptr<Object> IsList::Apply(const std::shared_ptr<Object>& args_head) {
-    std::vector<std::shared_ptr<Object>> elems = TakeElem(args_head);
-    if (elems[0] == nullptr ||
-        (Is<Symbol>(elems[0]) && As<Symbol>(elems[0])->TakeStringValue() == "()")) {
-        return std::make_shared<Symbol>("#t");
+Object* HashTableCount::Call(ArgumentsView elems) {
+    if (elems.size() != 1) {
+        throw RuntimeError("");
     }
-    std::shared_ptr<Object> now_ob = elems[0];
-    while (Is<Cell>(now_ob)) {
-        now_ob = As<Cell>(now_ob)->second_;
+    return MakeNumber(static_cast<int64_t>(ToHashTable(elems[0])->Size()));
+}
+
+Frame* Lambda::MakeFrame(Frame* parent, ArgumentsView args) {
+    if (args.size() < arity_ || (!variadic_ && args.size() > arity_)) {
+        throw RuntimeError("");
     }
-    if (now_ob != nullptr) {
-        return std::make_shared<Symbol>("#f");
+    Frame* frame = Make<Frame>(parent, frame_size_);
+    for (size_t i = 0; i < arity_; ++i) {
+        frame->Slot(i) = ToValue(args[i]);
+    }
+    if (variadic_) {
+        ArgumentsView rest(args.begin() + arity_, args.size() - arity_);
+        frame->Slot(arity_) = ToValue(MakeList(rest));
+    }
+    return frame;
+}
+
+namespace {
+
+template <class T>
+std::unique_ptr<Function> MakeBuiltin() {
+    return std::make_unique<T>();
+}
+
+struct BuiltinEntry {
+    std::string_view name;
+    std::unique_ptr<Function> (*make)();
+};
+
+constexpr BuiltinEntry kBuiltinEntries[] = {
+    {"'", MakeBuiltin<Quote>},
+    {"quote", MakeBuiltin<Quote>},
+    {"number?", MakeBuiltin<IsNumber>},
+    {"=", MakeBuiltin<Equality>},
+    {">", MakeBuiltin<SignMore>},
+    {"<", MakeBuiltin<SignLess>},
+    {">=", MakeBuiltin<SignME>},
+    {"<=", MakeBuiltin<SignLE>},
+    {"+", MakeBuiltin<Plus>},
+    {"-", MakeBuiltin<Minus>},
+    {"*", MakeBuiltin<Multiplication>},
+    {"/", MakeBuiltin<Devided>},
+    {"max", MakeBuiltin<Maximum>},
+    {"min", MakeBuiltin<Minimum>},
+    {"abs", MakeBuiltin<Modul>},
+    {"boolean?", MakeBuiltin<IsBool>},
+    {"not", MakeBuiltin<Not>},
+    {"and", MakeBuiltin<And>},
+    {"or", MakeBuiltin<Or>},
+    {"null?", MakeBuiltin<IsNull>},
+    {"list", MakeBuiltin<Liist>},
+    {"list-ref", MakeBuiltin<ListRef>},
+    {"list-tail", MakeBuiltin<ListTail>},
+    {"car", MakeBuiltin<Car>},
+    {"cdr", MakeBuiltin<Cdr>},
+    {"cons", MakeBuiltin<Cons>},
+    {"pair?", MakeBuiltin<Papair>},
+    {"list?", MakeBuiltin<IsList>},
+    {"vector?", MakeBuiltin<IsVector>},
+    {"vector", MakeBuiltin<VectorOf>},
+    {"make-vector", MakeBuiltin<NewVector>},
+    {"vector-length", MakeBuiltin<VectorLength>},
+    {"vector-ref", MakeBuiltin<VectorRef>},
+    {"vector-set!", MakeBuiltin<VectorSet>},
+    {"vector-fill!", MakeBuiltin<VectorFill>},
+    {"bytevector?", MakeBuiltin<IsBytevector>},
+    {"bytevector", MakeBuiltin<BytevectorOf>},
+    {"make-bytevector", MakeBuiltin<NewBytevector>},
+    {"bytevector-length", MakeBuiltin<BytevectorLength>},
+    {"bytevector-u8-ref", MakeBuiltin<BytevectorRef>},
+    {"bytevector-u8-set!", MakeBuiltin<BytevectorSet>},
+    {"make-hash-table", MakeBuiltin<NewHashTable>},
+    {"hash-table-ref", MakeBuiltin<HashTableRef>},
+    {"hash-table-set!", MakeBuiltin<HashTableSet>},
+    {"hash-table-delete!", MakeBuiltin<HashTableDelete>},
+    {"hash-table-count", MakeBuiltin<HashTableCount>},
+    {"lambda", MakeBuiltin<LambdaForm>},
+    {"let", MakeBuiltin<LetForm>},
+    {"define", MakeBuiltin<DefineForm>},
+    {"set!", MakeBuiltin<SetForm>},
+    {"if", MakeBuiltin<If>},
+    {"cond", MakeBuiltin<Cond>},
+    {"when", MakeBuiltin<When>},
+    {"unless", MakeBuiltin<Unless>},
+};
+
+constexpr bool EntriesMatchBuiltinNames() {
+    if (std::size(kBuiltinEntries) != kBuiltinCount) {
+        return false;
+    }
+    for (size_t i = 0; i < kBuiltinCount; ++i) {
+        if (kBuiltinEntries[i].name != kBuiltinNames[i]) {
+            return false;
+        }
     }
-    return std::make_shared<Symbol>("#t");
-}
\ No newline at end of file
+    return true;
+}
+
+// The symbol ids of the builtins follow kBuiltinNames, so each handler has to
+// sit at the index of its name.
+static_assert(EntriesMatchBuiltinNames());
+
+}  // namespace
+
+Function* FindBuiltin(SymbolId id) {
+    static const auto kBuiltins = [] {
+        std::array<std::unique_ptr<Function>, kBuiltinCount> builtins;
+        for (size_t i = 0; i < kBuiltinCount; ++i) {
+            builtins[i] = kBuiltinEntries[i].make();
+        }
+        return builtins;
+    }();
+    SymbolId index = id - kFirstBuiltinSymbol;
+    if (id < kFirstBuiltinSymbol || index >= kBuiltinCount) {
+        return nullptr;
+    }
+    return kBuiltins[index].get();
+}
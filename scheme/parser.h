@@ -1,10 +1,18 @@
 #pragma once
 
-#include <memory>
-
 #include "object.h"
 #include "tokenizer.h"
 
-std::shared_ptr<Object> ReadList(Tokenizer* tokenizer);
+#include <limits>
+
+// Lists and quotes nested deeper than max_depth are rejected with a SyntaxError.
+constexpr size_t kNoReadDepthLimit = std::numeric_limits<size_t>::max();
+
+// Reads the rest of a list whose opening bracket has already been consumed.
+Object* ReadList(Tokenizer* tokenizer, size_t max_depth = kNoReadDepthLimit);
+
+// Reads the next datum and leaves the tokenizer right after it.
+Object* ReadDatum(Tokenizer* tokenizer, size_t max_depth = kNoReadDepthLimit);
 
-std::shared_ptr<Object> Read(Tokenizer* tokenizer);
\ No newline at end of file
+// Reads a datum that has to make up the whole input.
+Object* Read(Tokenizer* tokenizer, size_t max_depth = kNoReadDepthLimit);
\ No newline at end of file
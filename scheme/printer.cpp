@@ -0,0 +1,170 @@
+#include "printer.h"
+
+#include <charconv>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Appends to a string, and passes it on to a stream when it gets long if
+// there is one.
+class Writer {
+public:
+    Writer(std::string* buffer, std::ostream* out) : buffer_(buffer), out_(out) {
+    }
+
+    void Write(std::string_view text) {
+        buffer_->append(text);
+        if (out_ != nullptr && buffer_->size() >= kFlushSize) {
+            Flush();
+        }
+    }
+
+    void Flush() {
+        out_->write(buffer_->data(), buffer_->size());
+        buffer_->clear();
+    }
+
+private:
+    static constexpr size_t kFlushSize = 1 << 16;
+
+    std::string* buffer_;
+    std::ostream* out_;
+};
+
+void WriteInteger(int64_t value, Writer* writer) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    writer->Write(std::string_view(digits, result.ptr - digits));
+}
+
+void WriteAtom(Object* value, Writer* writer) {
+    if (value == nullptr) {
+        writer->Write("()");
+    } else if (Symbol* symbol = As<Symbol>(value)) {
+        writer->Write(symbol->GetName());
+    } else if (Number* number = As<Number>(value); number != nullptr && number->IsSmall()) {
+        WriteInteger(number->GetValue(), writer);
+    } else if (Bytevector* bytevector = As<Bytevector>(value)) {
+        writer->Write("#u8(");
+        for (size_t i = 0; i < bytevector->Size(); ++i) {
+            if (i != 0) {
+                writer->Write(" ");
+            }
+            WriteInteger(bytevector->Get(i), writer);
+        }
+        writer->Write(")");
+    } else {
+        writer->Write(value->TakeStringValue());
+    }
+}
+
+bool IsEmptyCell(Cell* cell) {
+    return cell->GetFirst() == nullptr && cell->GetSecond() == nullptr;
+}
+
+// What is left to write, innermost last.
+struct Task {
+    enum Kind {
+        VALUE,     // object with its parentheses
+        ELEMENTS,  // of the Vector object, from index on
+        INSIDE,    // the Cell object and the rest of its list, without parentheses
+        REST,      // the rest of the list after the head of the Cell object
+        CLOSE,     // a closing parenthesis
+    };
+
+    Kind kind;
+    Object* object = nullptr;
+    size_t index = 0;
+};
+
+void Print(Object* value, Writer* writer) {
+    std::vector<Task> tasks = {{Task::VALUE, value}};
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+        switch (task.kind) {
+            case Task::VALUE:
+                if (Is<Cell>(task.object)) {
+                    writer->Write("(");
+                    tasks.push_back({Task::CLOSE});
+                    tasks.push_back({Task::INSIDE, task.object});
+                } else if (Is<Vector>(task.object)) {
+                    writer->Write("#(");
+                    tasks.push_back({Task::CLOSE});
+                    tasks.push_back({Task::ELEMENTS, task.object});
+                } else {
+                    WriteAtom(task.object, writer);
+                }
+                break;
+            case Task::ELEMENTS: {
+                Vector* vector = static_cast<Vector*>(task.object);
+                if (task.index == vector->Size()) {
+                    break;
+                }
+                if (task.index != 0) {
+                    writer->Write(" ");
+                }
+                tasks.push_back({Task::ELEMENTS, vector, task.index + 1});
+                tasks.push_back({Task::VALUE, vector->Get(task.index)});
+                break;
+            }
+            case Task::INSIDE: {
+                Cell* cell = static_cast<Cell*>(task.object);
+                if (IsEmptyCell(cell)) {
+                    writer->Write("()");
+                    break;
+                }
+                tasks.push_back({Task::REST, cell});
+                Object* first = cell->GetFirst();
+                tasks.push_back({Is<Cell>(first) ? Task::INSIDE : Task::VALUE, first});
+                break;
+            }
+            case Task::REST: {
+                Object* second = static_cast<Cell*>(task.object)->GetSecond();
+                if (second == nullptr) {
+                    break;
+                }
+                if (Cell* next = As<Cell>(second)) {
+                    if (!IsEmptyCell(next)) {
+                        writer->Write(" ");
+                        tasks.push_back({Task::INSIDE, next});
+                    }
+                } else {
+                    writer->Write(" . ");
+                    tasks.push_back({Task::VALUE, second});
+                }
+                break;
+            }
+            case Task::CLOSE:
+                writer->Write(")");
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+void Print(Object* value, std::string* out) {
+    Writer writer(out, nullptr);
+    Print(value, &writer);
+}
+
+void Print(Object* value, std::ostream* out) {
+    std::string buffer;
+    Writer writer(&buffer, out);
+    Print(value, &writer);
+    writer.Flush();
+}
+
+std::string Cell::TakeStringValue() {
+    std::string text;
+    Print(this, &text);
+    return text;
+}
+
+std::string Vector::TakeStringValue() {
+    std::string text;
+    Print(this, &text);
+    return text;
+}
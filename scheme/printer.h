@@ -0,0 +1,17 @@
+#pragma once
+
+#include "object.h"
+
+#include <ostream>
+#include <string>
+
+// Writes the text of value the way the interpreter shows results, nullptr as
+// the empty list. The printer keeps its own stack, so long and deeply nested
+// lists take heap space rather than native stack, and it writes the text of
+// fixnums, symbols and bytevectors straight into the output. A list in the
+// head of another list is written without its own parentheses.
+void Print(Object* value, std::string* out);
+
+// Goes through a buffer of fixed size, so printing a long list does not hold
+// all of its text in memory at once.
+void Print(Object* value, std::ostream* out);
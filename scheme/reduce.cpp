@@ -0,0 +1,169 @@
+#include "reduce.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+int64_t WrappingAdd(int64_t first, int64_t second) {
+    return static_cast<int64_t>(static_cast<uint64_t>(first) + static_cast<uint64_t>(second));
+}
+
+}  // namespace
+
+#if defined(__AVX2__)
+
+int64_t SumFixnums(const int64_t* values, size_t size) {
+    size_t i = 0;
+    __m256i sum = _mm256_setzero_si256();
+    for (; i + 4 <= size; i += 4) {
+        sum = _mm256_add_epi64(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    int64_t res = WrappingAdd(WrappingAdd(lanes[0], lanes[1]), WrappingAdd(lanes[2], lanes[3]));
+    for (; i < size; ++i) {
+        res = WrappingAdd(res, values[i]);
+    }
+    return res;
+}
+
+int64_t MaxFixnums(const int64_t* values, size_t size) {
+    size_t i = 0;
+    int64_t res = values[0];
+    if (size >= 4) {
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        for (i = 4; i + 4 <= size; i += 4) {
+            __m256i now = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            best = _mm256_blendv_epi8(best, now, _mm256_cmpgt_epi64(now, best));
+        }
+        alignas(32) int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+        res = std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+    }
+    for (; i < size; ++i) {
+        res = std::max(res, values[i]);
+    }
+    return res;
+}
+
+int64_t MinFixnums(const int64_t* values, size_t size) {
+    size_t i = 0;
+    int64_t res = values[0];
+    if (size >= 4) {
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        for (i = 4; i + 4 <= size; i += 4) {
+            __m256i now = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            best = _mm256_blendv_epi8(best, now, _mm256_cmpgt_epi64(best, now));
+        }
+        alignas(32) int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+        res = std::min({lanes[0], lanes[1], lanes[2], lanes[3]});
+    }
+    for (; i < size; ++i) {
+        res = std::min(res, values[i]);
+    }
+    return res;
+}
+
+#else
+
+#if defined(__SSE2__)
+
+int64_t SumFixnums(const int64_t* values, size_t size) {
+    size_t i = 0;
+    __m128i sum = _mm_setzero_si128();
+    for (; i + 2 <= size; i += 2) {
+        sum = _mm_add_epi64(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+    }
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+    int64_t res = WrappingAdd(lanes[0], lanes[1]);
+    for (; i < size; ++i) {
+        res = WrappingAdd(res, values[i]);
+    }
+    return res;
+}
+
+#else
+
+int64_t SumFixnums(const int64_t* values, size_t size) {
+    int64_t res = 0;
+    for (size_t i = 0; i < size; ++i) {
+        res = WrappingAdd(res, values[i]);
+    }
+    return res;
+}
+
+#endif
+
+// SSE2 has no 64-bit integer comparison, so these stay scalar below AVX2.
+int64_t MaxFixnums(const int64_t* values, size_t size) {
+    return *std::max_element(values, values + size);
+}
+
+int64_t MinFixnums(const int64_t* values, size_t size) {
+    return *std::min_element(values, values + size);
+}
+
+#endif
+
+double SumReals(double sum, const double* values, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+#if defined(__SSE2__)
+
+double MaxReals(const double* values, size_t size) {
+    size_t i = 0;
+    double res = values[0];
+    if (size >= 2) {
+        __m128d best = _mm_loadu_pd(values);
+        for (i = 2; i + 2 <= size; i += 2) {
+            best = _mm_max_pd(best, _mm_loadu_pd(values + i));
+        }
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, best);
+        res = std::max(lanes[0], lanes[1]);
+    }
+    for (; i < size; ++i) {
+        res = std::max(res, values[i]);
+    }
+    return res;
+}
+
+double MinReals(const double* values, size_t size) {
+    size_t i = 0;
+    double res = values[0];
+    if (size >= 2) {
+        __m128d best = _mm_loadu_pd(values);
+        for (i = 2; i + 2 <= size; i += 2) {
+            best = _mm_min_pd(best, _mm_loadu_pd(values + i));
+        }
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, best);
+        res = std::min(lanes[0], lanes[1]);
+    }
+    for (; i < size; ++i) {
+        res = std::min(res, values[i]);
+    }
+    return res;
+}
+
+#else
+
+double MaxReals(const double* values, size_t size) {
+    return *std::max_element(values, values + size);
+}
+
+double MinReals(const double* values, size_t size) {
+    return *std::min_element(values, values + size);
+}
+
+#endif
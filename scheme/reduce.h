@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Reductions over plain arrays of numbers, vectorized with AVX2 or SSE2 when
+// the target has them and the result does not depend on the order. size must
+// be at least one.
+
+// Wraps around on overflow: callers only pass values that cannot overflow.
+int64_t SumFixnums(const int64_t* values, size_t size);
+int64_t MaxFixnums(const int64_t* values, size_t size);
+int64_t MinFixnums(const int64_t* values, size_t size);
+
+// Adds the values to sum one by one, left to right. Reordering the additions
+// would change the last bits of the result, so this one is never vectorized.
+double SumReals(double sum, const double* values, size_t size);
+double MaxReals(const double* values, size_t size);
+double MinReals(const double* values, size_t size);
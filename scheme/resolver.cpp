@@ -0,0 +1,387 @@
+#include "resolver.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Symbols that evaluate to themselves unless a local variable shadows them:
+// #t, #f and the names of the builtins. They cannot be global variables.
+bool IsReservedName(SymbolId name) {
+    return name < kFirstBuiltinSymbol || FindBuiltin(name) != nullptr;
+}
+
+SymbolId ToVariableName(Object* name) {
+    Symbol* symbol = As<Symbol>(name);
+    if (symbol == nullptr || symbol->GetId() < kFirstBuiltinSymbol) {
+        throw SyntaxError("");
+    }
+    return symbol->GetId();
+}
+
+// The length of a proper list of forms. Throws SyntaxError for anything else.
+size_t CountForms(Object* forms) {
+    size_t count = 0;
+    for (; forms != nullptr; forms = As<Cell>(forms)->second_) {
+        if (!Is<Cell>(forms)) {
+            throw SyntaxError("");
+        }
+        ++count;
+    }
+    return count;
+}
+
+// A conditional form whose arguments are all expressions, at least min_count
+// and at most max_count of them.
+Object* ResolveConditional(Resolver* resolver, Cell* call, size_t min_count,
+                           size_t max_count = SIZE_MAX) {
+    size_t count = CountForms(call->second_);
+    if (count < min_count || count > max_count) {
+        throw SyntaxError("");
+    }
+    resolver->ResolveArguments(call->second_);
+    return call;
+}
+
+// (define variable value) or (set! variable value) with a resolved variable;
+// the value is queued to be resolved in place. The call is built anew: its
+// cells belong to a run that must not change.
+Object* MakeAssignment(Resolver* resolver, Cell* call, Object* variable, Object* value) {
+    Object* parts[] = {call->first_, variable, value};
+    Cell* assignment = As<Cell>(MakeList(ArgumentsView(parts, 3)));
+    resolver->ResolveExpression(&assignment->Advance(2)->first_);
+    return assignment;
+}
+
+}  // namespace
+
+Object* Resolver::Resolve(Object* expr, GlobalEnvironment* globals) {
+    Resolver resolver(globals);
+    resolver.ResolveExpression(&expr);
+    resolver.Run();
+    return expr;
+}
+
+void Resolver::Run() {
+    do {
+        steps_.insert(steps_.end(), queued_.rbegin(), queued_.rend());
+        queued_.clear();
+        Step step = steps_.back();
+        steps_.pop_back();
+        switch (step.kind) {
+            case Step::Kind::EXPRESSION:
+                *step.expr = ResolveTerm(*step.expr);
+                break;
+            case Step::Kind::ENTER_FRAME:
+                scopes_.push_back(step.scope);
+                break;
+            case Step::Kind::LEAVE_FRAME:
+                scopes_.pop_back();
+                break;
+        }
+    } while (!steps_.empty() || !queued_.empty());
+}
+
+void Resolver::ResolveExpression(Object** expr) {
+    queued_.push_back(Step{Step::Kind::EXPRESSION, expr});
+}
+
+Object* Resolver::ResolveTerm(Object* expr) {
+    if (Is<Symbol>(expr)) {
+        return ResolveVariable(As<Symbol>(expr));
+    }
+    Cell* call = As<Cell>(expr);
+    if (call == nullptr) {
+        return expr;
+    }
+    if (Is<Symbol>(call->first_)) {
+        if (LocalRef* local = Lookup(As<Symbol>(call->first_)->GetId())) {
+            call->first_ = local;
+            ResolveArguments(call->second_);
+            return call;
+        }
+    }
+    if (Function* func = FindFunction(call->first_)) {
+        return func->Resolve(this, call);
+    }
+    ResolveExpression(&call->first_);
+    ResolveArguments(call->second_);
+    return call;
+}
+
+void Resolver::ResolveArguments(Object* args_head) {
+    while (Is<Cell>(args_head)) {
+        Cell* now_cell = As<Cell>(args_head);
+        ResolveExpression(&now_cell->first_);
+        args_head = now_cell->second_;
+    }
+}
+
+Lambda* Resolver::ResolveLambda(Object* params, Object* body) {
+    EnterFrame();
+    size_t arity = 0;
+    for (; Is<Cell>(params); params = As<Cell>(params)->second_) {
+        DeclareParameter(As<Cell>(params)->first_);
+        ++arity;
+    }
+    bool variadic = params != nullptr;
+    if (variadic) {
+        DeclareParameter(params);
+    }
+    if (!Is<Cell>(body)) {
+        throw SyntaxError("");
+    }
+    DeclareDefinitions(body);
+    for (Object* rest = body; rest != nullptr; rest = As<Cell>(rest)->second_) {
+        if (!Is<Cell>(rest)) {
+            throw SyntaxError("");
+        }
+        ResolveExpression(&As<Cell>(rest)->first_);
+    }
+    size_t frame_size = LeaveFrame();
+    return Make<Lambda>(arity, variadic, frame_size, body);
+}
+
+Object* Resolver::ResolveDefinition(Object* name) {
+    if (scopes_.empty()) {
+        return ResolveGlobal(name);
+    }
+    SymbolId id = ToVariableName(name);
+    const Scope& scope = *scopes_.back();
+    auto it = std::find(scope.begin(), scope.end(), id);
+    if (it == scope.end()) {
+        // Not at the top of a body, see DeclareDefinitions.
+        throw SyntaxError("");
+    }
+    return Make<LocalRef>(id, 0, it - scope.begin());
+}
+
+Object* Resolver::ResolveAssignment(Object* name) {
+    if (LocalRef* local = Lookup(ToVariableName(name))) {
+        return local;
+    }
+    return ResolveGlobal(name);
+}
+
+// Frames are opened and closed right away, so that the declarations and
+// lookups of the builtin see them, and once more by the queued steps around
+// the expressions resolved inside them.
+void Resolver::EnterFrame() {
+    Scope* scope = &frames_.emplace_back();
+    scopes_.push_back(scope);
+    queued_.push_back(Step{Step::Kind::ENTER_FRAME, nullptr, scope});
+}
+
+size_t Resolver::LeaveFrame() {
+    size_t size = scopes_.back()->size();
+    scopes_.pop_back();
+    queued_.push_back(Step{Step::Kind::LEAVE_FRAME});
+    return size;
+}
+
+LocalRef* Resolver::Declare(Object* name) {
+    SymbolId id = ToVariableName(name);
+    Scope& scope = *scopes_.back();
+    auto it = std::find(scope.begin(), scope.end(), id);
+    if (it == scope.end()) {
+        it = scope.insert(scope.end(), id);
+    }
+    return Make<LocalRef>(id, 0, it - scope.begin());
+}
+
+void Resolver::DeclareParameter(Object* name) {
+    const Scope& scope = *scopes_.back();
+    if (std::find(scope.begin(), scope.end(), ToVariableName(name)) != scope.end()) {
+        throw SyntaxError("");
+    }
+    Declare(name);
+}
+
+LocalRef* Resolver::Lookup(SymbolId name) {
+    for (size_t depth = 0; depth < scopes_.size(); ++depth) {
+        const Scope& scope = *scopes_[scopes_.size() - 1 - depth];
+        auto it = std::find(scope.begin(), scope.end(), name);
+        if (it != scope.end()) {
+            return Make<LocalRef>(name, depth, it - scope.begin());
+        }
+    }
+    return nullptr;
+}
+
+Object* Resolver::ResolveVariable(Symbol* symbol) {
+    if (LocalRef* local = Lookup(symbol->GetId())) {
+        return local;
+    }
+    if (IsReservedName(symbol->GetId())) {
+        return symbol;
+    }
+    return Make<GlobalRef>(globals_->Get(symbol->GetId()));
+}
+
+GlobalRef* Resolver::ResolveGlobal(Object* name) {
+    SymbolId id = ToVariableName(name);
+    if (IsReservedName(id)) {
+        throw SyntaxError("");
+    }
+    return Make<GlobalRef>(globals_->Get(id));
+}
+
+void Resolver::DeclareDefinitions(Object* body) {
+    static const SymbolId kDefine = Intern("define");
+    for (; Is<Cell>(body); body = As<Cell>(body)->second_) {
+        Cell* form = As<Cell>(As<Cell>(body)->first_);
+        if (form == nullptr || !Is<Symbol>(form->first_) ||
+            As<Symbol>(form->first_)->GetId() != kDefine || Lookup(kDefine) != nullptr ||
+            !Is<Cell>(form->second_)) {
+            continue;
+        }
+        Object* target = As<Cell>(form->second_)->first_;
+        Declare(Is<Cell>(target) ? As<Cell>(target)->first_ : target);
+    }
+}
+
+Object* Function::Resolve(Resolver* resolver, Cell* call) {
+    resolver->ResolveArguments(call->second_);
+    return call;
+}
+
+Object* Quote::Resolve(Resolver*, Cell* call) {
+    return call;
+}
+
+Object* Liist::Resolve(Resolver*, Cell* call) {
+    return call;
+}
+
+Object* LambdaForm::Resolve(Resolver* resolver, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    if (args == nullptr) {
+        throw SyntaxError("");
+    }
+    return resolver->ResolveLambda(args->first_, args->second_);
+}
+
+// (let ((var init) ...) body...) is resolved as ((lambda (var ...) body...) init ...),
+// and the named (let name ((var init) ...) body...) as
+// (((lambda () (define name (lambda (var ...) body...)) name)) init ...).
+Object* LetForm::Resolve(Resolver* resolver, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    if (args == nullptr) {
+        throw SyntaxError("");
+    }
+    Object* name = nullptr;
+    if (Is<Symbol>(args->first_)) {
+        name = args->first_;
+        args = As<Cell>(args->second_);
+        if (args == nullptr) {
+            throw SyntaxError("");
+        }
+    }
+    std::vector<Object*> vars;
+    std::vector<Object*> inits;
+    Object* bindings = args->first_;
+    for (; Is<Cell>(bindings); bindings = As<Cell>(bindings)->second_) {
+        Cell* binding = As<Cell>(As<Cell>(bindings)->first_);
+        if (binding == nullptr || !Is<Cell>(binding->second_) ||
+            As<Cell>(binding->second_)->second_ != nullptr) {
+            throw SyntaxError("");
+        }
+        vars.push_back(binding->first_);
+        inits.push_back(As<Cell>(binding->second_)->first_);
+    }
+    if (bindings != nullptr) {
+        throw SyntaxError("");
+    }
+    Object* init_list = MakeList(ArgumentsView(inits.data(), inits.size()));
+    resolver->ResolveArguments(init_list);
+    Object* params = MakeList(ArgumentsView(vars.data(), vars.size()));
+    Object* procedure;
+    if (name == nullptr) {
+        procedure = resolver->ResolveLambda(params, args->second_);
+    } else {
+        static const SymbolId kDefine = Intern("define");
+        resolver->EnterFrame();
+        LocalRef* loop = resolver->Declare(name);
+        Object* define[] = {MakeSymbol(kDefine), loop,
+                            resolver->ResolveLambda(params, args->second_)};
+        Object* body[] = {MakeList(ArgumentsView(define, 3)), loop};
+        size_t frame_size = resolver->LeaveFrame();
+        Cell* make_loop = Make<Cell>();
+        make_loop->first_ = Make<Lambda>(0, false, frame_size, MakeList(ArgumentsView(body, 2)));
+        procedure = make_loop;
+    }
+    Cell* application = Make<Cell>();
+    application->first_ = procedure;
+    application->second_ = init_list;
+    return application;
+}
+
+Object* DefineForm::Resolve(Resolver* resolver, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    if (args == nullptr || !Is<Cell>(args->second_)) {
+        throw SyntaxError("");
+    }
+    if (Cell* signature = As<Cell>(args->first_)) {
+        Object* variable = resolver->ResolveDefinition(signature->first_);
+        return MakeAssignment(resolver, call, variable,
+                              resolver->ResolveLambda(signature->second_, args->second_));
+    }
+    Cell* value = As<Cell>(args->second_);
+    if (value->second_ != nullptr) {
+        throw SyntaxError("");
+    }
+    Object* variable = resolver->ResolveDefinition(args->first_);
+    return MakeAssignment(resolver, call, variable, value->first_);
+}
+
+Object* SetForm::Resolve(Resolver* resolver, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    if (args == nullptr || !Is<Cell>(args->second_) ||
+        As<Cell>(args->second_)->second_ != nullptr) {
+        throw SyntaxError("");
+    }
+    Object* variable = resolver->ResolveAssignment(args->first_);
+    return MakeAssignment(resolver, call, variable, As<Cell>(args->second_)->first_);
+}
+
+Object* And::Resolve(Resolver* resolver, Cell* call) {
+    return ResolveConditional(resolver, call, 0);
+}
+
+Object* Or::Resolve(Resolver* resolver, Cell* call) {
+    return ResolveConditional(resolver, call, 0);
+}
+
+Object* If::Resolve(Resolver* resolver, Cell* call) {
+    return ResolveConditional(resolver, call, 2, 3);
+}
+
+Object* Cond::Resolve(Resolver* resolver, Cell* call) {
+    CountForms(call->second_);
+    for (Object* clauses = call->second_; clauses != nullptr;
+         clauses = As<Cell>(clauses)->second_) {
+        Cell* clause = As<Cell>(As<Cell>(clauses)->first_);
+        if (clause == nullptr) {
+            throw SyntaxError("");
+        }
+        CountForms(clause);
+        if (IsElse(clause->first_)) {
+            // The else clause has a body and comes last.
+            if (clause->second_ == nullptr || As<Cell>(clauses)->second_ != nullptr) {
+                throw SyntaxError("");
+            }
+        } else {
+            resolver->ResolveExpression(&clause->first_);
+        }
+        resolver->ResolveArguments(clause->second_);
+    }
+    return call;
+}
+
+Object* When::Resolve(Resolver* resolver, Cell* call) {
+    return ResolveConditional(resolver, call, 2);
+}
+
+Object* Unless::Resolve(Resolver* resolver, Cell* call) {
+    return ResolveConditional(resolver, call, 2);
+}
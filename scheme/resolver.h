@@ -0,0 +1,96 @@
+#pragma once
+
+#include "environment.h"
+#include "object.h"
+
+#include <deque>
+#include <vector>
+
+// Binds the names of an expression before it is evaluated. Every variable is
+// replaced by a LocalRef with the (depth, slot) of its frame or by a GlobalRef
+// to its top-level binding, and every lambda by a Lambda that knows the size
+// of its frame, so that evaluation never looks a name up. Builtins drive the
+// resolution of their own calls through Function::Resolve. Malformed binding
+// forms raise SyntaxError.
+//
+// Like the reader, the resolver walks the tree with an explicit stack instead
+// of recursion. The expressions and frames a builtin asks for are queued and
+// resolved in order once its Resolve returns, so the native stack use does
+// not depend on the nesting depth.
+class Resolver {
+public:
+    explicit Resolver(GlobalEnvironment* globals) : globals_(globals) {
+    }
+
+    static Object* Resolve(Object* expr, GlobalEnvironment* globals);
+
+    // Queues *expr to be replaced by its resolved form. Calls are changed in place.
+    void ResolveExpression(Object** expr);
+
+    // Queues the elements of an argument list, the ones TakeElem evaluates.
+    void ResolveArguments(Object* args_head);
+
+    // A Lambda whose frame holds params, a parameter list the way lambda
+    // takes it, and the variables defined at the top of body. Its body is
+    // resolved in that frame after the expressions queued before.
+    Lambda* ResolveLambda(Object* params, Object* body);
+
+    // The variable (define name ...) binds: a global one at the top level,
+    // otherwise one of the innermost frame.
+    Object* ResolveDefinition(Object* name);
+
+    // The variable (set! name ...) assigns.
+    Object* ResolveAssignment(Object* name);
+
+    // Opens a new innermost frame, which has no slots yet. The expressions
+    // queued until LeaveFrame are resolved inside it.
+    void EnterFrame();
+
+    // Closes the innermost frame and returns its number of slots.
+    size_t LeaveFrame();
+
+    // The variable of the innermost frame called name, which gets a new slot
+    // if it has none yet.
+    LocalRef* Declare(Object* name);
+
+private:
+    // Names of the slots of one frame.
+    using Scope = std::vector<SymbolId>;
+
+    // One item of work: resolve an expression, or open or close a frame.
+    struct Step {
+        enum class Kind { EXPRESSION, ENTER_FRAME, LEAVE_FRAME };
+
+        Kind kind;
+        Object** expr = nullptr;
+        Scope* scope = nullptr;
+    };
+
+    // Carries out the queued steps, each one followed by the steps it queues.
+    void Run();
+
+    Object* ResolveTerm(Object* expr);
+
+    // The local variable called name, or nullptr if there is none.
+    LocalRef* Lookup(SymbolId name);
+
+    Object* ResolveVariable(Symbol* symbol);
+    GlobalRef* ResolveGlobal(Object* name);
+
+    // Declares a parameter, which must not repeat an earlier one.
+    void DeclareParameter(Object* name);
+
+    // Gives the variables that body defines at its top their slots up front,
+    // so the body can refer to them before their definitions.
+    void DeclareDefinitions(Object* body);
+
+    // The frames open where the step or the Resolve being run is, innermost last.
+    std::vector<Scope*> scopes_;
+    // Every frame opened so far; a deque keeps them in place for scopes_.
+    std::deque<Scope> frames_;
+    // Steps still to run, the next one last.
+    std::vector<Step> steps_;
+    // Steps queued by the step being run, in order.
+    std::vector<Step> queued_;
+    GlobalEnvironment* globals_;
+};
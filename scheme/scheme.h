@@ -3,24 +3,157 @@
 #include "tokenizer.h"
 #include "object.h"
 #include "parser.h"
+#include "printer.h"
+#include "compiler.h"
+#include "environment.h"
+#include "expression_cache.h"
+#include "fold.h"
+#include "resolver.h"
+#include "tree_walker.h"
+#include "vm.h"
 
 #include <istream>
+#include <ostream>
 #include <string>
-#include <memory>
-#include <sstream>
 
+// TREE_WALK evaluates the resolved expression directly, BYTECODE compiles it
+// and runs it on the virtual machine. Both give the same results and errors,
+// both keep nested expressions and non-tail calls off the native stack, run
+// tail calls in constant space and collect garbage within a form.
+enum class EvaluationMode { TREE_WALK, BYTECODE };
+
+// Runs each form through the resolver and the constant folder if enabled, and
+// then evaluates it in the chosen EvaluationMode. Nothing on the way uses
+// native stack in proportion to the nesting or the call depth.
 class Interpreter {
 public:
     Interpreter() = default;
 
     std::string Run(const std::string& now) {
-        std::stringstream ss{now};
-        Tokenizer tknzr{&ss};
-        std::shared_ptr<Object> lst = Read(&tknzr);
-        if (lst == nullptr) {
-            throw RuntimeError("");
+        std::string text;
+        Print(EvaluateSource(now), &text);
+        return text;
+    }
+
+    // Writes the value of now to out as it is printed, without building its
+    // text first.
+    void Run(const std::string& now, std::ostream* out) {
+        Print(EvaluateSource(now), out);
+    }
+
+    // Evaluates the top-level forms of the stream one by one and writes the
+    // value of each to out as soon as it is known. Memory stays bounded by the
+    // current form, not by the length of the input.
+    void Run(std::istream* in, std::ostream* out) {
+        Tokenizer tknzr{in};
+        while (!tknzr.IsEnd()) {
+            CollectGarbage();
+            HeapScope scope(&heap_);
+            Print(Evaluate(Prepare(ReadDatum(&tknzr, max_read_depth_))), out);
+            *out << '\n';
+        }
+    }
+
+    // Inputs nested deeper than this are rejected with a SyntaxError.
+    void SetMaxReadDepth(size_t depth) {
+        max_read_depth_ = depth;
+        cache_.Clear();
+    }
+
+    // Lets Run(const std::string&) remember the parsed and compiled form of up
+    // to capacity distinct sources, so that repeating one skips the tokenizer,
+    // the parser and the compiler. Zero, the default, turns the cache off.
+    void SetCacheCapacity(size_t capacity) {
+        cache_.SetCapacity(capacity);
+    }
+
+    const CacheStats& GetCacheStats() const {
+        return cache_.GetStats();
+    }
+
+    // Runs FoldConstants over every expression before evaluating it. This
+    // pays off when the expression is evaluated repeatedly through the cache.
+    void SetConstantFolding(bool enabled) {
+        constant_folding_ = enabled;
+        cache_.Clear();
+    }
+
+    void SetEvaluationMode(EvaluationMode mode) {
+        mode_ = mode;
+    }
+
+    GcStats GetGcStats() const {
+        return heap_.GetStats();
+    }
+
+private:
+    // The value stays valid until the next form is run.
+    Object* EvaluateSource(const std::string& now) {
+        CollectGarbage();
+        HeapScope scope(&heap_);
+        if (cache_.GetCapacity() == 0) {
+            Tokenizer tknzr{std::string_view(now)};
+            return Evaluate(Prepare(Read(&tknzr, max_read_depth_)));
+        }
+        ExpressionCache::Entry* entry = cache_.Find(now);
+        if (entry == nullptr) {
+            Tokenizer tknzr{std::string_view(now)};
+            entry = cache_.Insert(now, Prepare(Read(&tknzr, max_read_depth_)));
+        }
+        return Evaluate(entry);
+    }
+
+    Object* Evaluate(Object* expr) {
+        evaluating_ = expr;
+        if (mode_ == EvaluationMode::TREE_WALK) {
+            return walker_.Run(expr);
+        }
+        return vm_.Execute(Compiler::Compile(expr));
+    }
+
+    // Binds the variables of expr, then folds its constants if enabled.
+    Object* Prepare(Object* expr) {
+        Object* resolved = Resolver::Resolve(expr, &globals_);
+        return constant_folding_ ? FoldConstants(resolved) : resolved;
+    }
+
+    Object* Evaluate(ExpressionCache::Entry* entry) {
+        if (mode_ == EvaluationMode::TREE_WALK) {
+            return walker_.Run(entry->expr);
+        }
+        if (!entry->code) {
+            entry->code = Compiler::Compile(entry->expr);
         }
-        std::shared_ptr<Object> res = lst->Calculate();
-        return res->TakeStringValue();
+        return vm_.Execute(*entry->code);
     }
+
+    // Must only be called between forms: no object is referenced from the
+    // C++ stack then, so only the cached forms and the global variables are roots.
+    void CollectGarbage() {
+        evaluating_ = nullptr;
+        if (heap_.ShouldCollect()) {
+            std::vector<Object*> roots;
+            AppendRoots(&roots);
+            heap_.Collect(roots);
+        }
+    }
+
+    // The virtual machine and the tree walker add their own stacks to these
+    // when they collect in the middle of a form.
+    void AppendRoots(std::vector<Object*>* roots) const {
+        cache_.AppendRoots(roots);
+        globals_.AppendRoots(roots);
+        roots->push_back(evaluating_);
+    }
+
+    Heap heap_;
+    GlobalEnvironment globals_;
+    VirtualMachine vm_{[this](std::vector<Object*>* roots) { AppendRoots(roots); }};
+    TreeWalker walker_{[this](std::vector<Object*>* roots) { AppendRoots(roots); }};
+    ExpressionCache cache_;
+    EvaluationMode mode_ = EvaluationMode::BYTECODE;
+    size_t max_read_depth_ = kNoReadDepthLimit;
+    bool constant_folding_ = false;
+    // The uncached form being evaluated.
+    Object* evaluating_ = nullptr;
 };
\ No newline at end of file
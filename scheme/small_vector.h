@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Vector of trivially copyable values that keeps up to N of them inline and
+// only goes to the heap when it grows past that.
+template <class T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    SmallVector() = default;
+
+    SmallVector(const SmallVector& other) {
+        Assign(other);
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        Steal(&other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            Assign(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            Release();
+            Steal(&other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        Release();
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    T& operator[](size_t i) {
+        return data_[i];
+    }
+
+    const T& operator[](size_t i) const {
+        return data_[i];
+    }
+
+    T* begin() {
+        return data_;
+    }
+
+    T* end() {
+        return data_ + size_;
+    }
+
+    const T* begin() const {
+        return data_;
+    }
+
+    const T* end() const {
+        return data_ + size_;
+    }
+
+    void clear() {
+        size_ = 0;
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        std::memcpy(data, data_, size_ * sizeof(T));
+        Release();
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy = value;
+            reserve(capacity_ * 2);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+
+private:
+    bool IsInline() const {
+        return data_ == inline_;
+    }
+
+    void Release() {
+        if (!IsInline()) {
+            ::operator delete(data_);
+            data_ = inline_;
+            capacity_ = N;
+        }
+    }
+
+    void Assign(const SmallVector& other) {
+        reserve(other.size_);
+        std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    void Steal(SmallVector* other) {
+        if (other->IsInline()) {
+            std::memcpy(inline_, other->inline_, other->size_ * sizeof(T));
+        } else {
+            data_ = other->data_;
+            capacity_ = other->capacity_;
+            other->data_ = other->inline_;
+            other->capacity_ = N;
+        }
+        size_ = other->size_;
+        other->size_ = 0;
+    }
+
+    T* data_ = inline_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    T inline_[N];
+};
@@ -0,0 +1,36 @@
+#include "symbol_table.h"
+
+#include "builtins.h"
+
+SymbolTable& SymbolTable::Instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable::SymbolTable() {
+    Insert("#t");
+    Insert("#f");
+    Insert("()");
+    Insert(".");
+    for (std::string_view name : kBuiltinNames) {
+        Insert(name);
+    }
+}
+
+SymbolId SymbolTable::Intern(std::string_view name) {
+    if (size_t index = FindBuiltinName(name); index != kBuiltinCount) {
+        return kFirstBuiltinSymbol + index;
+    }
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    return Insert(name);
+}
+
+SymbolId SymbolTable::Insert(std::string_view name) {
+    SymbolId id = names_.size();
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using SymbolId = uint32_t;
+
+// Ids of the symbols the interpreter compares against itself. They are
+// interned first, in this order, so the ids are fixed.
+constexpr SymbolId kTrueSymbol = 0;
+constexpr SymbolId kFalseSymbol = 1;
+constexpr SymbolId kEmptyListSymbol = 2;
+constexpr SymbolId kDotSymbol = 3;
+
+// The builtin names from builtins.h follow, starting with the quote mark.
+constexpr SymbolId kFirstBuiltinSymbol = 4;
+constexpr SymbolId kQuoteMarkSymbol = kFirstBuiltinSymbol;
+
+class SymbolTable {
+public:
+    static SymbolTable& Instance();
+
+    SymbolId Intern(std::string_view name);
+
+    const std::string& Name(SymbolId id) const {
+        return names_[id];
+    }
+
+    size_t Size() const {
+        return names_.size();
+    }
+
+private:
+    SymbolTable();
+
+    SymbolId Insert(std::string_view name);
+
+    // std::deque never moves its elements, so the views in ids_ stay valid.
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+inline SymbolId Intern(std::string_view name) {
+    return SymbolTable::Instance().Intern(name);
+}
+
+inline const std::string& SymbolName(SymbolId id) {
+    return SymbolTable::Instance().Name(id);
+}
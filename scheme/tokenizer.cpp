@@ -1,4 +1,143 @@
 #include "tokenizer.h"
+#include "char_scan.h"
 
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
+bool Tokenizer::Refill(const char*& token_begin) {
+    if (in_ == nullptr || !*in_) {
+        return false;
+    }
+    size_t keep = end_ - token_begin;
+    size_t offset = pos_ - token_begin;
+    // Before the first block token_begin is null, so it is only measured
+    // against buffer_ when there is something to keep.
+    size_t begin = keep != 0 ? token_begin - buffer_.data() : 0;
+    if (buffer_.size() < keep + kBlockSize) {
+        buffer_.resize(keep + kBlockSize);
+    }
+    if (keep != 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin, keep);
+    }
+    in_->read(buffer_.data() + keep, kBlockSize);
+    size_t read = in_->gcount();
+    token_begin = buffer_.data();
+    pos_ = token_begin + offset;
+    end_ = token_begin + keep + read;
+    return read != 0;
+}
 
+void Tokenizer::ParseInteger(std::string_view digits, bool negative, ConstantToken* token) {
+    if (digits.size() <= kMaxExactDigits) {
+        int64_t value = ParseDigits(digits);
+        token->value = negative ? -value : value;
+        return;
+    }
+    BigInt big = BigInt::FromDecimal(digits, negative);
+    if (big.FitsInt64()) {
+        token->value = big.ToInt64();
+    } else {
+        token->big = std::move(big);
+    }
+}
+
+ConstantToken Tokenizer::ParseConstant(std::string_view text, bool negative) {
+    ConstantToken res;
+    if (size_t slash = text.find('/'); slash != std::string_view::npos) {
+        ParseInteger(text.substr(0, slash), negative, &res);
+        std::string_view denominator = text.substr(slash + 1);
+        if (denominator.find_first_not_of('0') == std::string_view::npos) {
+            throw SyntaxError("");
+        }
+        res.denominator = BigInt::FromDecimal(denominator, false);
+    } else if (text.find_first_of(".eE") != std::string_view::npos) {
+        double value = 0;
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (end != text.data() + text.size()) {
+            throw SyntaxError("");
+        }
+        if (error == std::errc::result_out_of_range) {
+            // from_chars leaves value alone then; strtod rounds to infinity or to zero.
+            value = std::strtod(std::string(text).c_str(), nullptr);
+        } else if (error != std::errc()) {
+            throw SyntaxError("");
+        }
+        res.real = negative ? -value : value;
+    } else {
+        ParseInteger(text, negative, &res);
+    }
+    return res;
+}
+
+void Tokenizer::SkipNumber(const char*& token_begin) {
+    if (Peek(0, token_begin) == '/' && IsDigit(Peek(1, token_begin))) {
+        ++pos_;
+        Skip(SkipDigits, token_begin);
+        return;
+    }
+    if (Peek(0, token_begin) == '.') {
+        ++pos_;
+        Skip(SkipDigits, token_begin);
+    }
+    char exponent = Peek(0, token_begin);
+    if (exponent == 'e' || exponent == 'E') {
+        char sign = Peek(1, token_begin);
+        size_t digit = sign == '+' || sign == '-' ? 2 : 1;
+        if (IsDigit(Peek(digit, token_begin))) {
+            pos_ += digit;
+            Skip(SkipDigits, token_begin);
+        }
+    }
+}
+
+void Tokenizer::Next() {
+    const char* begin = pos_;
+    do {
+        pos_ = SkipSpaces(pos_, end_);
+        begin = pos_;
+    } while (pos_ == end_ && Refill(begin));
+    if (pos_ == end_) {
+        flag_ = true;
+        lexeme_ = {};
+        return;
+    }
+    char now_symbol = *pos_++;
+    if (now_symbol == '\'') {
+        tkn_ = QuoteToken{};
+    } else if (now_symbol == '.') {
+        tkn_ = DotToken{};
+    } else if (now_symbol == ')') {
+        tkn_ = BracketToken::CLOSE;
+    } else if (now_symbol == '(') {
+        tkn_ = BracketToken::OPEN;
+    } else if (now_symbol == '#' && Peek(0, begin) == '(') {
+        ++pos_;
+        tkn_ = BracketToken::OPEN_VECTOR;
+    } else if (now_symbol == '#' && Peek(0, begin) == 'u' && Peek(1, begin) == '8' &&
+               Peek(2, begin) == '(') {
+        pos_ += 3;
+        tkn_ = BracketToken::OPEN_BYTEVECTOR;
+    } else if (IsSymbolStart(now_symbol)) {
+        Skip(SkipSymbolChars, begin);
+        tkn_ = SymbolToken(std::string_view(begin, pos_ - begin));
+    } else if (now_symbol == '+' || now_symbol == '-') {
+        if ((pos_ == end_ && !Refill(begin)) || !IsDigit(*pos_)) {
+            tkn_ = SymbolToken(std::string_view(begin, 1));
+        } else {
+            Skip(SkipDigits, begin);
+            SkipNumber(begin);
+            tkn_ = ParseConstant(std::string_view(begin + 1, pos_ - begin - 1), now_symbol == '-');
+        }
+    } else if (IsDigit(now_symbol)) {
+        Skip(SkipDigits, begin);
+        SkipNumber(begin);
+        tkn_ = ParseConstant(std::string_view(begin, pos_ - begin), false);
+    } else if (now_symbol == '/') {
+        tkn_ = SymbolToken(std::string_view(begin, 1));
+    } else {
+        throw SyntaxError("");
+    }
+    lexeme_ = std::string_view(begin, pos_ - begin);
+}
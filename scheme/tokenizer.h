@@ -1,16 +1,29 @@
 #pragma once
 
+#include "bigint.h"
 #include "error.h"
+#include "symbol_table.h"
 
 #include <variant>
 #include <optional>
 #include <istream>
+#include <string>
+#include <string_view>
 
 struct SymbolToken {
-    std::string name;
+    SymbolId id = 0;
+
+    SymbolToken() = default;
+
+    SymbolToken(std::string_view name) : id(Intern(name)) {
+    }
+
+    const std::string& Name() const {
+        return SymbolName(id);
+    }
 
     bool operator==(const SymbolToken& other) const {
-        return name == other.name;
+        return id == other.id;
     }
 };
 
@@ -26,13 +39,22 @@ struct DotToken {
     }
 };
 
-enum class BracketToken { OPEN, CLOSE };
+// OPEN_VECTOR and OPEN_BYTEVECTOR are the "#(" and "#u8(" that start vector
+// and bytevector literals; all of them end with CLOSE.
+enum class BracketToken { OPEN, CLOSE, OPEN_VECTOR, OPEN_BYTEVECTOR };
 
+// Integer literals that do not fit in int64_t are parsed straight into big.
+// A rational literal such as 7/2 also has a denominator, a decimal one such
+// as 1.5 or 1e3 only a real.
 struct ConstantToken {
-    int value;
+    int64_t value = 0;
+    std::optional<BigInt> big;
+    std::optional<BigInt> denominator;
+    std::optional<double> real;
 
     bool operator==(const ConstantToken& other) const {
-        return value == other.value;
+        return value == other.value && big == other.big && denominator == other.denominator &&
+               real == other.real;
     }
 };
 
@@ -40,127 +62,64 @@ using Token = std::variant<ConstantToken, BracketToken, SymbolToken, QuoteToken,
 
 class Tokenizer {
 public:
-    Tokenizer(std::istream* in) {
-        in_ = in;
+    // Scans the buffer in place, without copying it. It must outlive the tokenizer.
+    explicit Tokenizer(std::string_view input) : pos_(input.data()), end_(pos_ + input.size()) {
         Next();
+    }
 
+    // Reads the stream block by block, so only the current block is kept in memory.
+    Tokenizer(std::istream* in) : in_(in) {
+        Next();
     }
 
     bool IsEnd() {
         return flag_;
     }
 
-    void Next() {
-        char now_symbol = in_->peek();
-        if (now_symbol == EOF) {
-            flag_ = true;
-            return;
-        }
-        if (now_symbol == ' ' || now_symbol == '\t' || now_symbol == '\n') {
-            in_->get();
-            Next();
-            return;
-        }
-        if (now_symbol == '\'') {
-            in_->get();
-            QuoteToken now_token;
-            tkn_ = now_token;
-        } else if (now_symbol == '.') {
-            in_->get();
-            DotToken now_token;
-            tkn_ = now_token;
-        } else if (now_symbol == ')') {
-            in_->get();
-            BracketToken now_token = BracketToken::CLOSE;
-            tkn_ = now_token;
-        } else if (now_symbol == '(') {
-            in_->get();
-            BracketToken now_token = BracketToken::OPEN;
-            tkn_ = now_token;
-        } else if ((now_symbol >= 'A' && now_symbol <= 'z') || (now_symbol == '#') ||
-                   (now_symbol == '*') || (now_symbol >= '<' && now_symbol <= '>')) {
-            std::string str_fot_tkn;
-            str_fot_tkn.push_back(in_->get());
-            now_symbol = in_->peek();
-            while ((now_symbol >= 'A' && now_symbol <= 'z') || (now_symbol == '#') ||
-                   (now_symbol == '*') || (now_symbol >= '<' && now_symbol <= '>') ||
-                   (now_symbol >= '0' && now_symbol <= '9') || (now_symbol == '!') ||
-                   (now_symbol == '?') || (now_symbol == '-') || (now_symbol == '+')) {
-                if (now_symbol == EOF) {
-                    break;
-                }
-                str_fot_tkn.push_back(in_->get());
-                now_symbol = in_->peek();
-            }
-            SymbolToken now_token;
-            now_token.name = str_fot_tkn;
-            tkn_ = now_token;
-        } else if (now_symbol == '+' || now_symbol == '-') {
-            now_symbol = in_->get();
-            char next_symbol = in_->peek();
-            if (!(next_symbol >= '0' && next_symbol <= '9')) {
-                SymbolToken now_token;
-                now_token.name = now_symbol;
-                tkn_ = now_token;
-            } else {
-                std::string str_for_tkn;
-                str_for_tkn.push_back(now_symbol);
-                now_symbol = in_->peek();
-                while (now_symbol >= '0' && now_symbol <= '9') {
-                    if (now_symbol == EOF) {
-                        break;
-                    }
-                    str_for_tkn.push_back(in_->get());
-                    now_symbol = in_->peek();
-                }
-                bool flag_for_znak = false;
-                if (str_for_tkn[0] == '-') {
-                    flag_for_znak = true;
-                }
-                int res = str_for_tkn[1] - '0';
-                for (size_t i = 2; i < str_for_tkn.size(); ++i) {
-                    res = res * 10 + (str_for_tkn[i] - '0');
-                }
-                if (flag_for_znak) {
-                    res *= -1;
-                }
-                ConstantToken now_token;
-                now_token.value = res;
-                tkn_ = now_token;
-            }
-        } else if (now_symbol >= '0' && now_symbol <= '9') {
-            std::string str_for_tkn;
-            while (now_symbol >= '0' && now_symbol <= '9') {
-                if (now_symbol == EOF) {
-                    break;
-                }
-                str_for_tkn.push_back(in_->get());
-                now_symbol = in_->peek();
-            }
-            int res = str_for_tkn[0] - '0';
-            for (size_t i = 1; i < str_for_tkn.size(); ++i) {
-                res = res * 10 + (str_for_tkn[i] - '0');
-            }
-            ConstantToken now_token;
-            now_token.value = res;
-            tkn_ = now_token;
-        } else if (now_symbol == '/') {
-            now_symbol = in_->get();
-            SymbolToken now_token;
-            now_token.name = now_symbol;
-            tkn_ = now_token;
-
-        } else {
-            throw SyntaxError("");
-        }
-    }
+    void Next();
 
     Token GetToken() {
         return tkn_;
     }
 
+    // Source text of the current token. Valid until the next call to Next().
+    std::string_view GetLexeme() const {
+        return lexeme_;
+    }
+
 private:
+    static constexpr size_t kBlockSize = 4096;
+
+    static ConstantToken ParseConstant(std::string_view text, bool negative);
+    static void ParseInteger(std::string_view digits, bool negative, ConstantToken* token);
+
+    // Scans the rest of a number whose leading digits were just skipped.
+    void SkipNumber(const char*& token_begin);
+
+    // Character ahead of pos_, reading more input if needed; '\0' past the end.
+    char Peek(size_t ahead, const char*& token_begin) {
+        while (static_cast<size_t>(end_ - pos_) <= ahead && Refill(token_begin)) {
+        }
+        return static_cast<size_t>(end_ - pos_) > ahead ? pos_[ahead] : '\0';
+    }
+
+    // Reads more of the stream, keeping everything from token_begin on.
+    // Returns false once the input is exhausted.
+    bool Refill(const char*& token_begin);
+
+    // Advances over a run of characters, refilling as long as the run reaches the end.
+    template <class Scan>
+    void Skip(Scan scan, const char*& token_begin) {
+        do {
+            pos_ = scan(pos_, end_);
+        } while (pos_ == end_ && Refill(token_begin));
+    }
+
     Token tkn_;
-    std::istream* in_;
+    std::string_view lexeme_;
+    const char* pos_ = nullptr;
+    const char* end_ = nullptr;
+    std::istream* in_ = nullptr;
+    std::string buffer_;
     bool flag_ = false;
-};
\ No newline at end of file
+};
@@ -0,0 +1,407 @@
+#include "tree_walker.h"
+
+#include "heap.h"
+
+Object* Evaluate(Object* expr) {
+    TreeWalker walker;
+    return walker.Run(expr);
+}
+
+Object* TreeWalker::Run(Object* expr) {
+    frame_ = nullptr;
+    values_.clear();
+    steps_.clear();
+    queued_.clear();
+    WalkExpression(expr);
+    Loop();
+    return values_.back();
+}
+
+void TreeWalker::Loop() {
+    do {
+        steps_.insert(steps_.end(), queued_.rbegin(), queued_.rend());
+        queued_.clear();
+        Step step = steps_.back();
+        steps_.pop_back();
+        switch (step.kind) {
+            case Step::Kind::EXPRESSION:
+                WalkTerm(step.object);
+                break;
+            case Step::Kind::SEQUENCE: {
+                Cell* forms = As<Cell>(step.object);
+                WalkExpression(forms->first_);
+                if (forms->second_ != nullptr) {
+                    Pop();
+                    WalkSequence(forms->second_);
+                }
+                break;
+            }
+            case Step::Kind::PUSH:
+                values_.push_back(step.object);
+                break;
+            case Step::Kind::POP:
+                values_.pop_back();
+                break;
+            case Step::Kind::FAIL:
+                throw RuntimeError("");
+            case Step::Kind::CALL: {
+                size_t first = values_.size() - step.argc;
+                Object* result = static_cast<StrictFunction*>(step.func)
+                                     ->CallWith(ArgumentsView(values_.data() + first, step.argc));
+                values_.resize(first);
+                values_.push_back(result);
+                break;
+            }
+            case Step::Kind::APPLY:
+                CallClosure(step.argc);
+                break;
+            case Step::Kind::STORE:
+                StoreTop(step.object, step.define);
+                break;
+            case Step::Kind::CONTINUE: {
+                Object* value = values_.back();
+                values_.pop_back();
+                static_cast<ConditionalForm*>(step.func)->Continue(this, step.object, value);
+                break;
+            }
+            case Step::Kind::LEAVE:
+                frame_ = step.frame;
+                break;
+        }
+    } while (!steps_.empty() || !queued_.empty());
+}
+
+void TreeWalker::WalkExpression(Object* expr) {
+    Step step{Step::Kind::EXPRESSION};
+    step.object = expr;
+    queued_.push_back(step);
+}
+
+void TreeWalker::WalkTerm(Object* expr) {
+    if (IsSelfEvaluating(expr)) {
+        values_.push_back(expr);
+        return;
+    }
+    if (LocalRef* local = As<LocalRef>(expr)) {
+        Object* value = local->Locate(frame_);
+        if (value == nullptr) {
+            throw RuntimeError("");
+        }
+        values_.push_back(value);
+        return;
+    }
+    if (GlobalRef* global = As<GlobalRef>(expr)) {
+        Object* value = global->GetVariable()->value;
+        if (value == nullptr) {
+            throw NameError("");
+        }
+        values_.push_back(value);
+        return;
+    }
+    if (Lambda* lambda = As<Lambda>(expr)) {
+        values_.push_back(Make<Closure>(lambda, frame_));
+        return;
+    }
+    Cell* call = As<Cell>(expr);
+    if (call == nullptr) {
+        throw RuntimeError("");
+    }
+    Function* func = FindFunction(call->first_);
+    if (func == nullptr) {
+        WalkExpression(call->first_);
+        Apply(WalkArguments(call->second_));
+        return;
+    }
+    func->Walk(this, call);
+}
+
+void TreeWalker::WalkSequence(Object* forms) {
+    Step step{Step::Kind::SEQUENCE};
+    step.object = forms;
+    queued_.push_back(step);
+}
+
+size_t TreeWalker::WalkArguments(Object* args_head) {
+    size_t argc = 0;
+    while (args_head != nullptr) {
+        if (!Is<Cell>(args_head)) {
+            Push(args_head);
+            ++argc;
+            break;
+        }
+        Cell* now_cell = As<Cell>(args_head);
+        if (now_cell->first_ == nullptr && now_cell->second_ == nullptr) {
+            break;
+        }
+        if (now_cell->first_ != nullptr) {
+            WalkExpression(now_cell->first_);
+            ++argc;
+        }
+        args_head = now_cell->second_;
+    }
+    return argc;
+}
+
+void TreeWalker::Push(Object* value) {
+    Step step{Step::Kind::PUSH};
+    step.object = value;
+    queued_.push_back(step);
+}
+
+void TreeWalker::Pop() {
+    queued_.push_back(Step{Step::Kind::POP});
+}
+
+void TreeWalker::Fail() {
+    queued_.push_back(Step{Step::Kind::FAIL});
+}
+
+void TreeWalker::Call(StrictFunction* func, size_t argc) {
+    Step step{Step::Kind::CALL};
+    step.func = func;
+    step.argc = argc;
+    queued_.push_back(step);
+}
+
+void TreeWalker::Apply(size_t argc) {
+    Step step{Step::Kind::APPLY};
+    step.argc = argc;
+    queued_.push_back(step);
+}
+
+void TreeWalker::Store(Object* variable, bool define) {
+    Step step{Step::Kind::STORE};
+    step.object = variable;
+    step.define = define;
+    queued_.push_back(step);
+}
+
+void TreeWalker::Continue(ConditionalForm* form, Object* rest) {
+    Step step{Step::Kind::CONTINUE};
+    step.object = rest;
+    step.func = form;
+    queued_.push_back(step);
+}
+
+void TreeWalker::CallClosure(size_t argc) {
+    CollectIfDue();
+    size_t first = values_.size() - argc;
+    Closure* closure = As<Closure>(values_[first - 1]);
+    if (closure == nullptr) {
+        throw RuntimeError("");
+    }
+    Lambda* lambda = closure->GetLambda();
+    Frame* frame =
+        lambda->MakeFrame(closure->GetEnv(), ArgumentsView(values_.data() + first, argc));
+    values_.resize(first - 1);
+    // In tail position the caller's frame is never used again: whoever gets
+    // the value restores its own.
+    if (!steps_.empty() && steps_.back().kind != Step::Kind::LEAVE) {
+        Step leave{Step::Kind::LEAVE};
+        leave.frame = frame_;
+        steps_.push_back(leave);
+    }
+    frame_ = frame;
+    WalkSequence(lambda->GetBody());
+}
+
+void TreeWalker::StoreTop(Object* variable, bool define) {
+    Object*& top = values_.back();
+    top = ToValue(top);
+    if (LocalRef* local = As<LocalRef>(variable)) {
+        local->Locate(frame_) = top;
+        return;
+    }
+    GlobalVariable* global = As<GlobalRef>(variable)->GetVariable();
+    if (!define && global->value == nullptr) {
+        throw NameError("");
+    }
+    global->value = top;
+}
+
+void TreeWalker::CollectIfDue() {
+    Heap& heap = Heap::Current();
+    if (!roots_ || !heap.ShouldCollect()) {
+        return;
+    }
+    std::vector<Object*> roots(values_.begin(), values_.end());
+    roots.push_back(frame_);
+    for (const Step& step : steps_) {
+        roots.push_back(step.object);
+        roots.push_back(step.frame);
+    }
+    roots_(&roots);
+    heap.Collect(roots);
+}
+
+void StrictFunction::Walk(TreeWalker* walker, Cell* call) {
+    if (!AcceptsShape(call->second_)) {
+        walker->Fail();
+        return;
+    }
+    walker->Call(this, walker->WalkArguments(call->second_));
+}
+
+void Quote::Walk(TreeWalker* walker, Cell* call) {
+    walker->Push(call->second_ == nullptr ? EmptyList() : call->second_);
+}
+
+void Liist::Walk(TreeWalker* walker, Cell* call) {
+    walker->Push(call->second_ == nullptr ? EmptyList() : call->second_);
+}
+
+void IsNull::Walk(TreeWalker* walker, Cell* call) {
+    if (!Is<Cell>(call->second_)) {
+        walker->Fail();
+        return;
+    }
+    walker->WalkExpression(As<Cell>(call->second_)->first_);
+    walker->Call(this, 1);
+}
+
+namespace {
+
+// and/or go on with the arguments from rest on, which are not empty, until
+// one of them is false, or true. The last one is in tail position.
+void WalkShortCircuit(TreeWalker* walker, ConditionalForm* form, Object* rest) {
+    Cell* now_cell = As<Cell>(rest);
+    walker->WalkExpression(now_cell->first_);
+    if (now_cell->second_ != nullptr) {
+        walker->Continue(form, now_cell->second_);
+    }
+}
+
+// cond tries the clauses from clauses on.
+void WalkClauses(TreeWalker* walker, Cond* cond, Object* clauses) {
+    if (clauses == nullptr) {
+        walker->Push(EmptyList());
+        return;
+    }
+    Cell* clause = As<Cell>(As<Cell>(clauses)->first_);
+    if (Cond::IsElse(clause->first_)) {
+        walker->WalkSequence(clause->second_);
+        return;
+    }
+    walker->WalkExpression(clause->first_);
+    walker->Continue(cond, clauses);
+}
+
+// when runs its body if the test is true, unless if it is false.
+void ContinueGuarded(TreeWalker* walker, Object* body, Object* test_value, bool run_if) {
+    if (IsTruthy(test_value) != run_if) {
+        walker->Push(EmptyList());
+        return;
+    }
+    walker->WalkSequence(body);
+}
+
+}  // namespace
+
+void And::Walk(TreeWalker* walker, Cell* call) {
+    if (call->second_ == nullptr) {
+        walker->Push(True());
+        return;
+    }
+    WalkShortCircuit(walker, this, call->second_);
+}
+
+void And::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    if (!IsTruthy(value)) {
+        walker->Push(value);
+        return;
+    }
+    WalkShortCircuit(walker, this, rest);
+}
+
+void Or::Walk(TreeWalker* walker, Cell* call) {
+    if (call->second_ == nullptr) {
+        walker->Push(False());
+        return;
+    }
+    WalkShortCircuit(walker, this, call->second_);
+}
+
+void Or::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    if (IsTruthy(value)) {
+        walker->Push(value);
+        return;
+    }
+    WalkShortCircuit(walker, this, rest);
+}
+
+void If::Walk(TreeWalker* walker, Cell* call) {
+    Cell* test = As<Cell>(call->second_);
+    walker->WalkExpression(test->first_);
+    walker->Continue(this, test->second_);
+}
+
+void If::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    Cell* branches = As<Cell>(rest);
+    if (IsTruthy(value)) {
+        walker->WalkExpression(branches->first_);
+    } else if (branches->second_ == nullptr) {
+        walker->Push(EmptyList());
+    } else {
+        walker->WalkExpression(As<Cell>(branches->second_)->first_);
+    }
+}
+
+void Cond::Walk(TreeWalker* walker, Cell* call) {
+    WalkClauses(walker, this, call->second_);
+}
+
+void Cond::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    Cell* clauses = As<Cell>(rest);
+    if (!IsTruthy(value)) {
+        WalkClauses(walker, this, clauses->second_);
+        return;
+    }
+    Cell* clause = As<Cell>(clauses->first_);
+    if (clause->second_ == nullptr) {
+        walker->Push(value);
+        return;
+    }
+    walker->WalkSequence(clause->second_);
+}
+
+void When::Walk(TreeWalker* walker, Cell* call) {
+    Cell* test = As<Cell>(call->second_);
+    walker->WalkExpression(test->first_);
+    walker->Continue(this, test->second_);
+}
+
+void When::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    ContinueGuarded(walker, rest, value, true);
+}
+
+void Unless::Walk(TreeWalker* walker, Cell* call) {
+    Cell* test = As<Cell>(call->second_);
+    walker->WalkExpression(test->first_);
+    walker->Continue(this, test->second_);
+}
+
+void Unless::Continue(TreeWalker* walker, Object* rest, Object* value) {
+    ContinueGuarded(walker, rest, value, false);
+}
+
+void LambdaForm::Walk(TreeWalker* walker, Cell*) {
+    walker->Fail();
+}
+
+void LetForm::Walk(TreeWalker* walker, Cell*) {
+    walker->Fail();
+}
+
+void DefineForm::Walk(TreeWalker* walker, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    walker->WalkExpression(As<Cell>(args->second_)->first_);
+    walker->Store(args->first_, true);
+    walker->Pop();
+    walker->Push(MakeSymbol(GetVariableName(args->first_)));
+}
+
+void SetForm::Walk(TreeWalker* walker, Cell* call) {
+    Cell* args = As<Cell>(call->second_);
+    walker->WalkExpression(As<Cell>(args->second_)->first_);
+    walker->Store(args->first_, false);
+}
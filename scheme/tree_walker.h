@@ -0,0 +1,107 @@
+#pragma once
+
+#include "object.h"
+
+#include <functional>
+#include <vector>
+
+// Evaluates a resolved expression as it is, without compiling it. Builtins
+// drive the evaluation of their own calls through Function::Walk, using the
+// primitives below, and a conditional form picks up the value of a test it
+// asked for in ConditionalForm::Continue.
+//
+// Like the compiler, the walker keeps an explicit stack of steps instead of
+// recursing. Every primitive queues a step, and the steps a builtin queues are
+// carried out in order once its Walk returns, each expression leaving its
+// value on a stack of values. A closure call is a step too, and so is giving
+// the caller its frame back, which a tail call leaves to its caller's caller.
+// So neither the nesting of expressions nor the depth of calls uses native
+// stack, and loops run in constant space.
+class TreeWalker {
+public:
+    // Adds the objects that the expression being walked may still use,
+    // besides those on the walker's own stacks, to roots.
+    using RootSource = std::function<void(std::vector<Object*>* roots)>;
+
+    TreeWalker() = default;
+
+    // With a root source the walker collects garbage of the current heap
+    // when a call finds it due.
+    explicit TreeWalker(RootSource roots) : roots_(std::move(roots)) {
+    }
+
+    // The value of expr evaluated at the top level.
+    Object* Run(Object* expr);
+
+    // Evaluates expr, leaving its value on the stack.
+    void WalkExpression(Object* expr);
+
+    // Evaluates a non-empty list of forms in turn and leaves the value of the
+    // last one, which is in tail position if the list is.
+    void WalkSequence(Object* forms);
+
+    // Pushes the arguments the way TakeElem evaluates them and returns how
+    // many there are.
+    size_t WalkArguments(Object* args_head);
+
+    void Push(Object* value);
+    void Pop();
+    void Fail();
+
+    // Replaces the top argc values by the value of func called with them.
+    void Call(StrictFunction* func, size_t argc);
+
+    // Calls the closure below the top argc values with them.
+    void Apply(size_t argc);
+
+    // Variables are LocalRefs or GlobalRefs. A store leaves the value on the stack.
+    void Store(Object* variable, bool define);
+
+    // Takes the top value off the stack and passes it to form->Continue along
+    // with rest, which tells the form where it is.
+    void Continue(ConditionalForm* form, Object* rest);
+
+private:
+    // One item of work. LEAVE gives the frame of a caller back once its
+    // callee is done.
+    struct Step {
+        enum class Kind {
+            EXPRESSION,
+            SEQUENCE,
+            PUSH,
+            POP,
+            FAIL,
+            CALL,
+            APPLY,
+            STORE,
+            CONTINUE,
+            LEAVE
+        };
+
+        Kind kind;
+        // The expression, the forms, the value, the variable, or the rest
+        // passed to Continue.
+        Object* object = nullptr;
+        Function* func = nullptr;
+        size_t argc = 0;
+        bool define = false;
+        Frame* frame = nullptr;
+    };
+
+    // Carries out the queued steps, each one followed by the steps it queues.
+    void Loop();
+
+    void WalkTerm(Object* expr);
+    void CallClosure(size_t argc);
+    void StoreTop(Object* variable, bool define);
+    void CollectIfDue();
+
+    RootSource roots_;
+    // The frame of the closure call being evaluated, nullptr at the top level.
+    Frame* frame_ = nullptr;
+    std::vector<Object*> values_;
+    // Steps still to run, the next one last.
+    std::vector<Step> steps_;
+    // Steps queued by the step being run, in order.
+    std::vector<Step> queued_;
+};
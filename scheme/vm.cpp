@@ -0,0 +1,182 @@
+#include "vm.h"
+
+#include "heap.h"
+
+Object* VirtualMachine::Execute(const Code& code) {
+    stack_.clear();
+    stack_.reserve(code.max_stack);
+    calls_.clear();
+    calls_.push_back(Activation{&code, nullptr, nullptr, nullptr, 0});
+    const Code* now = &code;
+    const Instruction* pc = code.instructions.data();
+    Frame* frame = nullptr;
+    while (true) {
+        switch (pc->op) {
+            case OpCode::PUSH:
+                stack_.push_back(now->constants[pc->a]);
+                ++pc;
+                break;
+            case OpCode::POP:
+                stack_.pop_back();
+                ++pc;
+                break;
+            case OpCode::LOAD_LOCAL: {
+                Object* value = frame->Up(pc->a)->Slot(pc->b);
+                if (value == nullptr) {
+                    throw RuntimeError("");
+                }
+                stack_.push_back(value);
+                ++pc;
+                break;
+            }
+            case OpCode::STORE_LOCAL: {
+                Object*& top = stack_.back();
+                top = ToValue(top);
+                frame->Up(pc->a)->Slot(pc->b) = top;
+                ++pc;
+                break;
+            }
+            case OpCode::LOAD_GLOBAL: {
+                Object* value = now->globals[pc->a]->value;
+                if (value == nullptr) {
+                    throw NameError("");
+                }
+                stack_.push_back(value);
+                ++pc;
+                break;
+            }
+            case OpCode::STORE_GLOBAL:
+            case OpCode::DEFINE_GLOBAL: {
+                GlobalVariable* variable = now->globals[pc->a];
+                if (pc->op == OpCode::STORE_GLOBAL && variable->value == nullptr) {
+                    throw NameError("");
+                }
+                Object*& top = stack_.back();
+                top = ToValue(top);
+                variable->value = top;
+                ++pc;
+                break;
+            }
+            case OpCode::CLOSURE:
+                stack_.push_back(Make<Closure>(static_cast<Lambda*>(now->constants[pc->a]), frame));
+                ++pc;
+                break;
+            case OpCode::APPLY:
+            case OpCode::TAIL_APPLY: {
+                CollectIfDue();
+                size_t first = stack_.size() - pc->b;
+                Closure* closure = As<Closure>(stack_[first - 1]);
+                if (closure == nullptr) {
+                    throw RuntimeError("");
+                }
+                Lambda* lambda = closure->GetLambda();
+                frame = lambda->MakeFrame(closure->GetEnv(),
+                                          ArgumentsView(stack_.data() + first, pc->b));
+                if (pc->op == OpCode::TAIL_APPLY) {
+                    stack_.resize(calls_.back().base);
+                    calls_.pop_back();
+                } else {
+                    stack_.resize(first - 1);
+                    calls_.back().pc = pc + 1;
+                }
+                now = &lambda->GetCode();
+                calls_.push_back(Activation{now, nullptr, frame, lambda, stack_.size()});
+                pc = now->instructions.data();
+                break;
+            }
+            case OpCode::CALL: {
+                size_t first = stack_.size() - pc->b;
+                Object* result =
+                    now->functions[pc->a]->Call(ArgumentsView(stack_.data() + first, pc->b));
+                stack_.resize(first);
+                stack_.push_back(result);
+                ++pc;
+                break;
+            }
+            case OpCode::CALL1: {
+                Object*& top = stack_.back();
+                top = now->functions[pc->a]->Call1(top);
+                ++pc;
+                break;
+            }
+            case OpCode::CALL2: {
+                Object* second = stack_.back();
+                stack_.pop_back();
+                Object*& top = stack_.back();
+                top = now->functions[pc->a]->Call2(top, second);
+                ++pc;
+                break;
+            }
+            case OpCode::CALL3: {
+                Object* third = stack_.back();
+                stack_.pop_back();
+                Object* second = stack_.back();
+                stack_.pop_back();
+                Object*& top = stack_.back();
+                top = now->functions[pc->a]->Call3(top, second, third);
+                ++pc;
+                break;
+            }
+            case OpCode::JUMP:
+                pc = now->instructions.data() + pc->a;
+                break;
+            case OpCode::JUMP_IF_FALSE:
+            case OpCode::JUMP_IF_TRUE: {
+                bool truthy = IsTruthy(stack_.back());
+                stack_.pop_back();
+                if (truthy == (pc->op == OpCode::JUMP_IF_TRUE)) {
+                    pc = now->instructions.data() + pc->a;
+                } else {
+                    ++pc;
+                }
+                break;
+            }
+            case OpCode::JUMP_IF_FALSE_OR_POP:
+                if (!IsTruthy(stack_.back())) {
+                    pc = now->instructions.data() + pc->a;
+                } else {
+                    stack_.pop_back();
+                    ++pc;
+                }
+                break;
+            case OpCode::JUMP_IF_TRUE_OR_POP:
+                if (IsTruthy(stack_.back())) {
+                    pc = now->instructions.data() + pc->a;
+                } else {
+                    stack_.pop_back();
+                    ++pc;
+                }
+                break;
+            case OpCode::FAIL:
+                throw RuntimeError("");
+            case OpCode::RETURN: {
+                Object* result = stack_.back();
+                stack_.resize(calls_.back().base);
+                calls_.pop_back();
+                if (calls_.empty()) {
+                    return result;
+                }
+                stack_.push_back(result);
+                const Activation& caller = calls_.back();
+                now = caller.code;
+                pc = caller.pc;
+                frame = caller.frame;
+                break;
+            }
+        }
+    }
+}
+
+void VirtualMachine::CollectIfDue() {
+    Heap& heap = Heap::Current();
+    if (!roots_ || !heap.ShouldCollect()) {
+        return;
+    }
+    std::vector<Object*> roots(stack_.begin(), stack_.end());
+    for (const Activation& call : calls_) {
+        roots.push_back(call.frame);
+        roots.push_back(call.lambda);
+    }
+    roots_(&roots);
+    heap.Collect(roots);
+}
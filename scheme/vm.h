@@ -0,0 +1,43 @@
+#pragma once
+
+#include "bytecode.h"
+#include "object.h"
+
+#include <functional>
+
+// Stack machine that runs the Code produced by Compiler. Calls of closures
+// push activations on an explicit stack instead of the native one, and tail
+// calls replace the current activation, so loops run in constant space.
+class VirtualMachine {
+public:
+    // Adds the objects that the program run by the machine may still use,
+    // besides those on its own stacks, to roots.
+    using RootSource = std::function<void(std::vector<Object*>* roots)>;
+
+    VirtualMachine() = default;
+
+    // With a root source the machine collects garbage of the current heap
+    // when a call finds it due.
+    explicit VirtualMachine(RootSource roots) : roots_(std::move(roots)) {
+    }
+
+    Object* Execute(const Code& code);
+
+private:
+    struct Activation {
+        const Code* code;
+        // Where to continue once the callee returns.
+        const Instruction* pc;
+        Frame* frame;
+        // Owns code, nullptr for the code passed to Execute.
+        Lambda* lambda;
+        // Size of the stack below the values of this activation.
+        size_t base;
+    };
+
+    void CollectIfDue();
+
+    RootSource roots_;
+    std::vector<Object*> stack_;
+    std::vector<Activation> calls_;
+};
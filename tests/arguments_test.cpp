@@ -0,0 +1,34 @@
+#include "test_util.h"
+
+class ArgumentsTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(ArgumentsTest);
+
+TEST_P(ArgumentsTest, EvaluatedOnceLeftToRight) {
+    Eval("(define trace 0)");
+    Eval("(define (step k) (set! trace (+ (* trace 10) k)) k)");
+    EXPECT_EQ(Eval("(+ (step 1) (step 2) (step 3) (step 4) (step 5) (step 6))"), "21");
+    EXPECT_EQ(Eval("trace"), "123456");
+    Eval("(set! trace 0)");
+    Eval("(define (f . args) args)");
+    EXPECT_EQ(Eval("(f (step 3) (step 2) (step 1))"), "(3 2 1)");
+    EXPECT_EQ(Eval("trace"), "321");
+}
+
+TEST_P(ArgumentsTest, ManyArguments) {
+    std::string call = "(+";
+    for (int i = 1; i <= 50000; ++i) {
+        call += " " + std::to_string(i);
+    }
+    EXPECT_EQ(Eval(call + ")"), "1250025000");
+    EXPECT_EQ(Eval(call + " 'x)"), "RuntimeError");
+    Eval("(define (count . args) (if (null? args) 0 (+ 1 (count-list (cdr args)))))");
+    Eval("(define (count-list xs) (if (null? xs) 0 (+ 1 (count-list (cdr xs)))))");
+    EXPECT_EQ(Eval("(count 1 2 3 4 5 6 7 8 9 10)"), "10");
+}
+
+// TakeElem has always evaluated the tail of a dotted call as one more argument.
+TEST_P(ArgumentsTest, DottedTailIsTheLastArgument) {
+    EXPECT_EQ(Eval("(+ 1 . 2)"), "3");
+    EXPECT_EQ(Eval("(+ 1 2 . 3)"), "6");
+}
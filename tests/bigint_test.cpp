@@ -0,0 +1,112 @@
+#include "bigint.h"
+#include "test_util.h"
+
+#include <random>
+
+namespace {
+
+BigInt Parse(std::string_view text) {
+    bool negative = !text.empty() && text[0] == '-';
+    return BigInt::FromDecimal(negative ? text.substr(1) : text, negative);
+}
+
+// A random integer with digits decimal digits, negative half of the time.
+BigInt RandomBig(std::mt19937_64* random, size_t digits) {
+    std::string text(digits, '0');
+    for (char& c : text) {
+        c = '0' + (*random)() % 10;
+    }
+    text[0] = '1' + (*random)() % 9;
+    return BigInt::FromDecimal(text, (*random)() % 2 == 0);
+}
+
+}  // namespace
+
+TEST(BigIntTest, DecimalRoundTrip) {
+    for (const char* text : {"0", "1", "-1", "4294967295", "4294967296", "-9223372036854775808",
+                             "18446744073709551616", "123456789012345678901234567890"}) {
+        EXPECT_EQ(Parse(text).ToString(), text);
+    }
+    EXPECT_EQ(Parse("-0").ToString(), "0");
+    EXPECT_EQ(Parse("000123").ToString(), "123");
+}
+
+TEST(BigIntTest, Int64Boundaries) {
+    EXPECT_TRUE(Parse("9223372036854775807").FitsInt64());
+    EXPECT_TRUE(Parse("-9223372036854775808").FitsInt64());
+    EXPECT_FALSE(Parse("9223372036854775808").FitsInt64());
+    EXPECT_FALSE(Parse("-9223372036854775809").FitsInt64());
+    EXPECT_EQ(Parse("-9223372036854775808").ToInt64(), INT64_MIN);
+}
+
+TEST(BigIntTest, KnownProductAndQuotient) {
+    BigInt a = Parse(
+        "70550791086553325712464271575934796216507949612787315762871223209262085551582934156579"
+        "298529447134158154952334825355911866929793071824566694145084454535257027960285323760313"
+        "192443283334088001");
+    BigInt b = Parse(
+        "58170929338243431654325240033916911649198596497193405326275672076076568590343569955665"
+        "89707894210757866827613621721127496191249");
+    EXPECT_EQ((a * b).ToString(),
+              "41040050830530680477768117226165863897699675598679938020339415453142840086417266889"
+              "47471369816185316342416088680948034196149116631283378791950842373307379677839564464"
+              "48256429559548076968588542777255229973555203812738211267033399938448754566566216371"
+              "559998675095857134026250139253506902268745616410732618099136492103249");
+    EXPECT_EQ((a / b).ToString(), "12128187032448006039648119297136651727627895246102243188306571398");
+    EXPECT_EQ((a % b).ToString(),
+              "41113035900029838936561687053758854476296068240065211064939801513861952611759563710"
+              "26017682828215060514678118814337880452791899");
+    EXPECT_EQ((-a / b).ToString(), "-12128187032448006039648119297136651727627895246102243188306571398");
+    EXPECT_EQ(((-a) % b).IsNegative(), true);
+    EXPECT_EQ((a / -b).IsNegative(), true);
+    EXPECT_EQ(((a % -b) == (a % b)), true);
+}
+
+// Identities that only hold if multiplication, Karatsuba included, and
+// division agree with each other and with addition.
+TEST(BigIntTest, MultiplicationAndDivisionAgree) {
+    std::mt19937_64 random(42);
+    for (size_t digits : {1, 9, 10, 19, 20, 300, 310, 700, 1500, 3000}) {
+        for (int round = 0; round < 4; ++round) {
+            BigInt a = RandomBig(&random, digits);
+            BigInt b = RandomBig(&random, digits / 2 + 1 + random() % digits);
+            BigInt c = RandomBig(&random, digits);
+            BigInt product = a * b;
+            EXPECT_EQ(product, b * a);
+            EXPECT_EQ(product / b, a) << digits;
+            EXPECT_TRUE((product % b).IsZero());
+            EXPECT_EQ(a * (b + c), product + a * c) << digits;
+            BigInt quotient = c / b;
+            BigInt remainder = c % b;
+            EXPECT_EQ(quotient * b + remainder, c) << digits;
+            EXPECT_LT(Compare(remainder.IsNegative() ? -remainder : remainder,
+                              b.IsNegative() ? -b : b),
+                      0);
+        }
+    }
+}
+
+TEST(BigIntTest, Compare) {
+    EXPECT_LT(Compare(Parse("-100000000000000000000"), Parse("-1")), 0);
+    EXPECT_GT(Compare(Parse("100000000000000000000"), Parse("99999999999999999999")), 0);
+    EXPECT_EQ(Compare(Parse("-0"), Parse("0")), 0);
+}
+
+class BigNumbersTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(BigNumbersTest);
+
+TEST_P(BigNumbersTest, OverflowPromotes) {
+    EXPECT_EQ(Eval("(+ 9223372036854775807 1)"), "9223372036854775808");
+    EXPECT_EQ(Eval("(- -9223372036854775808 1)"), "-9223372036854775809");
+    EXPECT_EQ(Eval("(* 4294967296 4294967296)"), "18446744073709551616");
+    EXPECT_EQ(Eval("(- 9223372036854775808 1)"), "9223372036854775807");
+    EXPECT_EQ(Eval("(abs -9223372036854775808)"), "9223372036854775808");
+}
+
+TEST_P(BigNumbersTest, Factorial) {
+    Eval("(define (fact n) (if (= n 0) 1 (* n (fact (- n 1)))))");
+    EXPECT_EQ(Eval("(fact 50)"), "30414093201713378043612608166064768844377641568960512000000000000");
+    EXPECT_EQ(Eval("(/ (fact 50) (fact 48))"), "2450");
+    EXPECT_EQ(Eval("(/ (fact 20) (fact 22))"), "1/462");
+}
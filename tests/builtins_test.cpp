@@ -0,0 +1,36 @@
+#include "builtins.h"
+#include "test_util.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+TEST(BuiltinsTest, EveryNameIsFound) {
+    for (size_t i = 0; i < kBuiltinCount; ++i) {
+        EXPECT_EQ(FindBuiltinName(kBuiltinNames[i]), i);
+        EXPECT_EQ(Intern(kBuiltinNames[i]), kFirstBuiltinSymbol + i);
+        EXPECT_NE(FindBuiltin(Intern(kBuiltinNames[i])), nullptr) << kBuiltinNames[i];
+    }
+}
+
+TEST(BuiltinsTest, OtherNamesAreNotFound) {
+    for (std::string_view name : {"", "call/cc", "cadr", "lis", "list-tails", "vector-set"}) {
+        EXPECT_EQ(FindBuiltinName(name), kBuiltinCount) << name;
+    }
+    EXPECT_EQ(FindBuiltin(Intern("not-a-builtin")), nullptr);
+}
+
+TEST(BuiltinsTest, NamesAreDistinct) {
+    std::set<std::string_view> names(std::begin(kBuiltinNames), std::end(kBuiltinNames));
+    EXPECT_EQ(names.size(), kBuiltinCount);
+}
+
+TEST(BuiltinsTest, NamesCallTheirHandlers) {
+    Interpreter interpreter;
+    EXPECT_EQ(Eval(&interpreter, "(car '(1 2))"), "1");
+    EXPECT_EQ(Eval(&interpreter, "(cdr '(1 2))"), "(2)");
+    EXPECT_EQ(Eval(&interpreter, "(list-tail '(1 2 3) 1)"), "(2 3)");
+    EXPECT_EQ(Eval(&interpreter, "(vector-length (make-vector 3 0))"), "3");
+    EXPECT_EQ(Eval(&interpreter, "(hash-table-count (make-hash-table))"), "0");
+    EXPECT_EQ(Eval(&interpreter, "(unless #f 7)"), "7");
+}
@@ -0,0 +1,92 @@
+#include "test_util.h"
+
+#include <vector>
+
+namespace {
+
+// Runs every form of the script in order and collects what each printed.
+std::vector<std::string> RunScript(Interpreter* interpreter, const std::vector<std::string>& script) {
+    std::vector<std::string> results;
+    for (const std::string& form : script) {
+        results.push_back(Eval(interpreter, form));
+    }
+    return results;
+}
+
+const std::vector<std::string> kScript = {
+    "(define v #(0 0))",
+    "(vector-set! v 0 5)",
+    "(define v #(0 0))",
+    "v",
+    "(define w (vector 0 0))",
+    "(vector-set! w 0 5)",
+    "(define w (vector 0 0))",
+    "w",
+    "(define b (make-bytevector 2 0))",
+    "(bytevector-u8-set! b 1 3)",
+    "(define b (make-bytevector 2 0))",
+    "b",
+    "(define x 1)",
+    "(set! x (+ x 1))",
+    "(set! x (+ x 1))",
+    "x",
+    "(define f (lambda (n) (if (= n 0) '() (cons n (f (- n 1))))))",
+    "(f 3)",
+    "(f 3)",
+    "(define h (make-hash-table))",
+    "(hash-table-set! h 'k (+ (hash-table-ref h 'k 0) 1))",
+    "(hash-table-set! h 'k (+ (hash-table-ref h 'k 0) 1))",
+    "(hash-table-ref h 'k)",
+    "'(1 2 . 3)",
+    "'(1 2 . 3)",
+    "(car '())",
+    "(car '())",
+    "undefined-variable",
+};
+
+}  // namespace
+
+TEST(CacheTest, CachedRunsMatchUncachedRuns) {
+    for (EvaluationMode mode : {EvaluationMode::TREE_WALK, EvaluationMode::BYTECODE}) {
+        Interpreter uncached;
+        uncached.SetEvaluationMode(mode);
+        std::vector<std::string> expected = RunScript(&uncached, kScript);
+        for (size_t capacity : {1, 2, 8, 64}) {
+            Interpreter cached;
+            cached.SetEvaluationMode(mode);
+            cached.SetCacheCapacity(capacity);
+            EXPECT_EQ(RunScript(&cached, kScript), expected) << "capacity " << capacity;
+        }
+    }
+}
+
+TEST(CacheTest, CountsHitsAndMisses) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(2);
+    for (const char* form : {"(+ 1 2)", "(+ 1 2)", "(* 2 3)", "(+ 1 2)", "(- 5 1)", "(* 2 3)"}) {
+        Eval(&interpreter, form);
+    }
+    const CacheStats& stats = interpreter.GetCacheStats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 4u);
+}
+
+TEST(CacheTest, ErrorsAreNotCached) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(8);
+    EXPECT_EQ(Eval(&interpreter, "(+ 1"), "SyntaxError");
+    EXPECT_EQ(Eval(&interpreter, "(+ 1"), "SyntaxError");
+    EXPECT_EQ(Eval(&interpreter, "y"), "NameError");
+    Eval(&interpreter, "(define y 4)");
+    EXPECT_EQ(Eval(&interpreter, "y"), "4");
+}
+
+TEST(CacheTest, SurvivesCollections) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(4);
+    Eval(&interpreter, "(define make (lambda (n acc) (if (= n 0) acc (make (- n 1) (cons n acc)))))");
+    for (int i = 0; i < 30; ++i) {
+        EXPECT_EQ(Eval(&interpreter, "(car (make 20000 '(#(1 2))))"), "1");
+    }
+    EXPECT_GT(interpreter.GetGcStats().collections, 0u);
+}
@@ -0,0 +1,58 @@
+#include "char_scan.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+
+// Runs of every length up to a few vector widths, ending in every character,
+// so both the vector loop and the scalar tail are covered.
+template <class Skip, class InClass>
+void CheckSkip(Skip skip, InClass in_class, char inside) {
+    for (size_t length = 0; length <= 100; ++length) {
+        for (int c = 0; c < 256; ++c) {
+            std::string text(length, inside);
+            text.push_back(static_cast<char>(c));
+            text += "xyz";
+            size_t expected = in_class(static_cast<char>(c)) ? length + 1 : length;
+            if (expected == length + 1) {
+                expected += in_class('x') ? 3 : 0;
+            }
+            const char* begin = text.data();
+            ASSERT_EQ(skip(begin, begin + text.size()) - begin, static_cast<ptrdiff_t>(expected))
+                << "length " << length << ", character " << c;
+            // The end bound is respected even if the class goes on past it.
+            ASSERT_EQ(skip(begin, begin + length) - begin, static_cast<ptrdiff_t>(length));
+        }
+    }
+}
+
+}  // namespace
+
+TEST(CharScanTest, SkipSpaces) {
+    CheckSkip(SkipSpaces, IsSpace, ' ');
+    CheckSkip(SkipSpaces, IsSpace, '\n');
+}
+
+TEST(CharScanTest, SkipDigits) {
+    CheckSkip(SkipDigits, IsDigit, '7');
+}
+
+TEST(CharScanTest, SkipSymbolChars) {
+    CheckSkip(SkipSymbolChars, IsSymbolChar, 'a');
+    CheckSkip(SkipSymbolChars, IsSymbolChar, '?');
+}
+
+TEST(CharScanTest, ScalarScans) {
+    CheckSkip(SkipSpacesScalar, IsSpace, ' ');
+    CheckSkip(SkipDigitsScalar, IsDigit, '7');
+    CheckSkip(SkipSymbolCharsScalar, IsSymbolChar, 'a');
+}
+
+TEST(CharScanTest, ParseDigits) {
+    EXPECT_EQ(ParseDigits("0"), 0u);
+    EXPECT_EQ(ParseDigits("12345678"), 12345678u);
+    EXPECT_EQ(ParseDigits("000000000000000042"), 42u);
+    EXPECT_EQ(ParseDigits("999999999999999999"), 999999999999999999u);
+}
@@ -0,0 +1,59 @@
+#include "test_util.h"
+
+class ConditionalsTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(ConditionalsTest);
+
+TEST_P(ConditionalsTest, OnlyFalseIsFalse) {
+    EXPECT_EQ(Eval("(if #f 'yes 'no)"), "no");
+    for (const char* value : {"0", "'()", "#t", "'a", "#()", "1.5"}) {
+        EXPECT_EQ(Eval(std::string("(if ") + value + " 'yes 'no)"), "yes") << value;
+    }
+}
+
+TEST_P(ConditionalsTest, AndOrReturnTheDecidingValue) {
+    EXPECT_EQ(Eval("(and)"), "#t");
+    EXPECT_EQ(Eval("(or)"), "#f");
+    EXPECT_EQ(Eval("(and 1 2 'c)"), "c");
+    EXPECT_EQ(Eval("(and 1 #f 'c)"), "#f");
+    EXPECT_EQ(Eval("(or #f '() 3)"), "()");
+    EXPECT_EQ(Eval("(or #f #f)"), "#f");
+}
+
+TEST_P(ConditionalsTest, ShortCircuit) {
+    Eval("(define hits 0)");
+    Eval("(define (hit) (set! hits (+ hits 1)) #t)");
+    Eval("(and #f (hit))");
+    Eval("(or #t (hit))");
+    Eval("(if #t 1 (hit))");
+    Eval("(when #f (hit))");
+    Eval("(unless #t (hit))");
+    Eval("(cond (#t 1) ((hit) 2))");
+    EXPECT_EQ(Eval("hits"), "0");
+    Eval("(and #t (hit))");
+    Eval("(cond (#f 1) ((hit) 2))");
+    EXPECT_EQ(Eval("hits"), "2");
+}
+
+TEST_P(ConditionalsTest, IfWhenUnless) {
+    EXPECT_EQ(Eval("(if (> 2 1) (+ 1 1) (car '()))"), "2");
+    EXPECT_EQ(Eval("(when (> 2 1) 1 2 3)"), "3");
+    EXPECT_EQ(Eval("(unless (> 1 2) 'a 'b)"), "b");
+    EXPECT_EQ(Eval("(if)"), "SyntaxError");
+    EXPECT_EQ(Eval("(if 1)"), "SyntaxError");
+    EXPECT_EQ(Eval("(if 1 2 3 4)"), "SyntaxError");
+    EXPECT_EQ(Eval("(when #t)"), "SyntaxError");
+}
+
+TEST_P(ConditionalsTest, Cond) {
+    EXPECT_EQ(Eval("(cond ((= 1 2) 'a) ((= 1 1) 'b 'c) (else 'd))"), "c");
+    EXPECT_EQ(Eval("(cond (#f 1) (else 2))"), "2");
+    EXPECT_EQ(Eval("(cond (7))"), "7");
+    EXPECT_EQ(Eval("(cond (else))"), "SyntaxError");
+    EXPECT_EQ(Eval("(cond (else 1) (#t 2))"), "SyntaxError");
+    EXPECT_EQ(Eval("(cond 1)"), "SyntaxError");
+    Eval("(define (classify n) (cond ((< n 0) 'negative) ((= n 0) 'zero) (else 'positive)))");
+    EXPECT_EQ(Eval("(classify -3)"), "negative");
+    EXPECT_EQ(Eval("(classify 0)"), "zero");
+    EXPECT_EQ(Eval("(classify 9)"), "positive");
+}
@@ -0,0 +1,63 @@
+#include "test_util.h"
+
+#include <vector>
+
+namespace {
+
+// Programs whose forms are run in order; every configuration has to print
+// the same thing for each form, errors included.
+const std::vector<std::vector<std::string>> kPrograms = {
+    {"(+ 1 2 3)", "(- 10 1 2)", "(* 2 3 4)", "(/ 12 3 2)", "(max 1 5 3)", "(min 4 2 8)",
+     "(abs -5)", "(+)", "(*)", "(-)", "(/ 1 0)", "(+ 1 'a)"},
+    {"(< 1 2 3)", "(< 1 3 2)", "(= 2 2 2)", "(>= 3 3 1)", "(<= 1)", "(number? 5)",
+     "(boolean? #f)", "(not 1)", "(not #f)", "(null? '())", "(pair? '(1 . 2))", "(list? '(1 2))"},
+    {"(define xs '(1 2 3 4 5))", "(car xs)", "(cdr xs)", "(list-ref xs 3)", "(list-tail xs 2)",
+     "(list-ref xs 10)", "(cons 0 xs)", "(car (cdr (cdr xs)))", "(car '())"},
+    {"(define (fib n) (if (< n 2) n (+ (fib (- n 1)) (fib (- n 2)))))", "(fib 15)",
+     "(define (compose f g) (lambda (x) (f (g x))))", "((compose (lambda (x) (* x 2)) fib) 10)",
+     "(define add (lambda args (if (null? args) 0 (+ (car args) (apply-rest (cdr args))))))",
+     "(define (apply-rest args) (if (null? args) 0 (+ (car args) (apply-rest (cdr args)))))",
+     "(add 1 2 3 4)"},
+    {"(define counter 0)", "(define (bump!) (set! counter (+ counter 1)) counter)", "(bump!)",
+     "(bump!)", "counter", "(define (f) (g))", "(f)", "(define (g) 'late)", "(f)"},
+    {"(and)", "(or)", "(and 1 2 3)", "(or #f #f 4)", "(and 1 #f undefined)", "(or 1 undefined)",
+     "(if #f 1)", "(if '() 'empty-is-true 'no)", "(cond (#f 1) ((+ 1 1)) (else 3))",
+     "(when (> 2 1) 'a 'b)", "(unless (> 2 1) 'a)"},
+    {"(define v (make-vector 3 0))", "(vector-set! v 1 'x)", "(vector-ref v 1)",
+     "(vector-length #(1 2 3))", "(define b (bytevector 1 2 3))", "(bytevector-u8-ref b 2)",
+     "(define h (make-hash-table))", "(hash-table-set! h '(a b) 1)", "(hash-table-ref h '(a b))"},
+    {"(1 2)", "(lambda)", "(let ((x 1) (x 2)) x)", "(define)", "((lambda (x) x) 1 2)",
+     "unknown", "(car)", "(cdr 1 2)"},
+};
+
+class EvaluationTest : public ::testing::TestWithParam<Configuration> {};
+
+INSTANTIATE_TEST_SUITE_P(Configurations, EvaluationTest, ::testing::ValuesIn(kConfigurations),
+                         [](const ::testing::TestParamInfo<Configuration>& info) {
+                             return ConfigurationName(info.param);
+                         });
+
+}  // namespace
+
+// The plain tree walk is the reference every other configuration must match.
+TEST_P(EvaluationTest, MatchesTheTreeWalker) {
+    for (const std::vector<std::string>& program : kPrograms) {
+        Interpreter reference;
+        reference.SetEvaluationMode(EvaluationMode::TREE_WALK);
+        Interpreter interpreter;
+        Configure(&interpreter, GetParam());
+        for (const std::string& form : program) {
+            EXPECT_EQ(Eval(&interpreter, form), Eval(&reference, form)) << form;
+        }
+    }
+}
+
+TEST(EvaluationTest, CompiledFormsAreReusedAcrossRuns) {
+    Interpreter interpreter;
+    interpreter.SetCacheCapacity(4);
+    Eval(&interpreter, "(define (square x) (* x x))");
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(Eval(&interpreter, "(square 12)"), "144");
+    }
+    EXPECT_EQ(interpreter.GetCacheStats().hits, 99u);
+}
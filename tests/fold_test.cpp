@@ -0,0 +1,81 @@
+#include "test_util.h"
+
+#include <sstream>
+
+namespace {
+
+// The expression after resolution and, if fold, folding, printed.
+std::string Prepared(const std::string& source, bool fold) {
+    GlobalEnvironment globals;
+    std::istringstream in(source);
+    Tokenizer tokenizer{&in};
+    Object* expr = Resolver::Resolve(Read(&tokenizer), &globals);
+    if (fold) {
+        expr = FoldConstants(expr);
+    }
+    if (Lambda* lambda = As<Lambda>(expr)) {
+        expr = lambda->GetBody();
+    }
+    std::string text;
+    Print(expr, &text);
+    return text;
+}
+
+std::string Folded(const std::string& source) {
+    return Prepared(source, true);
+}
+
+std::string Unfolded(const std::string& source) {
+    return Prepared(source, false);
+}
+
+}  // namespace
+
+TEST(FoldTest, PureCalls) {
+    EXPECT_EQ(Folded("(+ 1 (* 2 3))"), "7");
+    EXPECT_EQ(Folded("(car '(1 2))"), "1");
+    EXPECT_EQ(Folded("(cdr '(1 2))"), "(quote 2)");
+    EXPECT_EQ(Folded("(if (< 1 2) 'yes 'no)"), "yes");
+}
+
+TEST(FoldTest, ErrorsAreKeptForRunTime) {
+    EXPECT_EQ(Folded("(+ 1 (car 'a))"), Unfolded("(+ 1 (car 'a))"));
+}
+
+TEST(FoldTest, InsideDefinitionsAndAssignments) {
+    EXPECT_EQ(Folded("(define y (+ 1 (* 2 3)))").substr(0, 8), "(define ");
+    EXPECT_NE(Folded("(define y (+ 1 (* 2 3)))").find(" 7)"), std::string::npos);
+    EXPECT_NE(Folded("(set! y (- 10 3))").find(" 7)"), std::string::npos);
+}
+
+TEST(FoldTest, InsideImpureCallsAndClosureCalls) {
+    EXPECT_EQ(Folded("(vector (+ 1 2) (* 2 2))"), "(vector 3 4)");
+    EXPECT_NE(Folded("(f (+ 1 2))").find(" 3)"), std::string::npos);
+}
+
+TEST(FoldTest, InsideLambdaBodies) {
+    EXPECT_EQ(Folded("(lambda (x) (+ 1 2) (* x (+ 1 1)))").find("(+ 1 2)"), std::string::npos);
+    EXPECT_NE(Folded("(lambda (x) (* x (+ 1 1)))").find(" 2)"), std::string::npos);
+}
+
+TEST(FoldTest, QuotedDataIsNotChanged) {
+    EXPECT_EQ(Folded("'(+ 1 2)"), Unfolded("'(+ 1 2)"));
+    EXPECT_EQ(Folded("(quote (+ 1 2))"), Unfolded("(quote (+ 1 2))"));
+}
+
+class FoldEquivalenceTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(FoldEquivalenceTest);
+
+TEST_P(FoldEquivalenceTest, FoldedFormsKeepTheirValues) {
+    EXPECT_EQ(Eval("(define y (+ 1 (* 2 3)))"), "y");
+    EXPECT_EQ(Eval("y"), "7");
+    EXPECT_EQ(Eval("(set! y (- y (+ 1 1)))"), "5");
+    EXPECT_EQ(Eval("(define v (vector (+ 1 2) 'a))"), "v");
+    EXPECT_EQ(Eval("(vector-set! v 0 (* 2 (+ 1 1)))"), "#(4 a)");
+    EXPECT_EQ(Eval("(define (f x) (+ x (* 2 3)))"), "f");
+    EXPECT_EQ(Eval("(f (+ 1 1))"), "8");
+    EXPECT_EQ(Eval("(let ((a (+ 1 2))) (* a (- 5 3)))"), "6");
+    EXPECT_EQ(Eval("(define (g) (+ 1 (car 'a)))"), "g");
+    EXPECT_EQ(Eval("(g)"), "RuntimeError");
+}
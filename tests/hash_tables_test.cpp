@@ -0,0 +1,77 @@
+#include "test_util.h"
+
+class HashTablesTest : public InterpreterTest {
+protected:
+    void SetUp() override {
+        InterpreterTest::SetUp();
+        Eval("(define h (make-hash-table))");
+    }
+};
+
+INSTANTIATE_CONFIGURATIONS(HashTablesTest);
+
+TEST_P(HashTablesTest, SetRefDelete) {
+    Eval("(hash-table-set! h 'a 1)");
+    Eval("(hash-table-set! h 'b 2)");
+    Eval("(hash-table-set! h 'a 3)");
+    EXPECT_EQ(Eval("(hash-table-ref h 'a)"), "3");
+    EXPECT_EQ(Eval("(hash-table-count h)"), "2");
+    EXPECT_EQ(Eval("(hash-table-ref h 'c)"), "RuntimeError");
+    EXPECT_EQ(Eval("(hash-table-ref h 'c 'none)"), "none");
+    EXPECT_EQ(Eval("(hash-table-delete! h 'a)"), "#<hash-table>");
+    EXPECT_EQ(Eval("(hash-table-delete! h 'a)"), "#<hash-table>");
+    EXPECT_EQ(Eval("(hash-table-count h)"), "1");
+}
+
+TEST_P(HashTablesTest, StructuralKeys) {
+    Eval("(hash-table-set! h '(1 (2 3)) 'list)");
+    Eval("(hash-table-set! h 100000000000000000000 'big)");
+    Eval("(hash-table-set! h 1/2 'half)");
+    EXPECT_EQ(Eval("(hash-table-ref h (list 1 (2 3)))"), "list");
+    EXPECT_EQ(Eval("(hash-table-ref h (* 10000000000 10000000000))"), "big");
+    EXPECT_EQ(Eval("(hash-table-ref h (/ 2 4))"), "half");
+    EXPECT_EQ(Eval("(hash-table-ref h 0.5 'none)"), "none");
+}
+
+TEST_P(HashTablesTest, DeeplyNestedKeys) {
+    const int depth = 200000;
+    auto nested = [depth](const std::string& innermost) {
+        std::string list;
+        for (int i = 0; i < depth; ++i) {
+            list += "(1 ";
+        }
+        return list + innermost + std::string(depth, ')');
+    };
+    Eval("(hash-table-set! h '" + nested("2") + " 'deep)");
+    EXPECT_EQ(Eval("(hash-table-ref h '" + nested("2") + ")"), "deep");
+    EXPECT_EQ(Eval("(hash-table-ref h '" + nested("3") + " 'none)"), "none");
+}
+
+TEST_P(HashTablesTest, SignedZeroIsOneKey) {
+    Eval("(hash-table-set! h 0.0 1)");
+    EXPECT_EQ(Eval("(hash-table-ref h -0.0 'none)"), "1");
+    Eval("(hash-table-set! h -0.0 2)");
+    EXPECT_EQ(Eval("(hash-table-count h)"), "1");
+    EXPECT_EQ(Eval("(hash-table-ref h 0 'none)"), "none");
+}
+
+TEST_P(HashTablesTest, NaNMatchesNoOtherKey) {
+    Eval("(define nan (/ 0.0 0.0))");
+    Eval("(hash-table-set! h 1.0 'one)");
+    Eval("(hash-table-set! h nan 'nan)");
+    EXPECT_EQ(Eval("(hash-table-ref h 1.0)"), "one");
+    EXPECT_EQ(Eval("(hash-table-ref h nan)"), "nan");
+    EXPECT_EQ(Eval("(hash-table-ref h (/ 0.0 0.0) 'none)"), "none");
+    EXPECT_EQ(Eval("(hash-table-count h)"), "2");
+}
+
+TEST_P(HashTablesTest, ManyKeysSurviveGrowthAndDeletion) {
+    Eval("(define (fill i) (if (< i 2000) (begin-fill i) 'done))");
+    Eval("(define (begin-fill i) (hash-table-set! h i (* i i)) (fill (+ i 1)))");
+    EXPECT_EQ(Eval("(fill 0)"), "done");
+    Eval("(define (drop i) (when (< i 2000) (hash-table-delete! h i) (drop (+ i 2))))");
+    Eval("(drop 0)");
+    EXPECT_EQ(Eval("(hash-table-count h)"), "1000");
+    EXPECT_EQ(Eval("(hash-table-ref h 1999)"), "3996001");
+    EXPECT_EQ(Eval("(hash-table-ref h 1998 'gone)"), "gone");
+}
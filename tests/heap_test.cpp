@@ -0,0 +1,55 @@
+#include "test_util.h"
+
+#include <gtest/gtest.h>
+
+TEST(HeapTest, CollectFreesUnreachableObjects) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Cell* kept = Make<Cell>();
+    kept->first_ = Make<Number>(int64_t{1});
+    Make<Number>(int64_t{2});
+    Make<Cell>()->first_ = Make<Number>(int64_t{3});
+    EXPECT_EQ(heap.GetStats().objects_live, 5u);
+
+    heap.Collect({kept});
+    GcStats stats = heap.GetStats();
+    EXPECT_EQ(stats.collections, 1u);
+    EXPECT_EQ(stats.objects_live, 2u);
+    EXPECT_EQ(stats.bytes_freed + stats.bytes_live, stats.bytes_allocated);
+    EXPECT_EQ(As<Number>(kept->first_)->GetValue(), 1);
+}
+
+TEST(HeapTest, FreedSlotsAreReused) {
+    Heap heap;
+    HeapScope scope(&heap);
+    for (int i = 0; i < 1000; ++i) {
+        Make<Cell>();
+    }
+    size_t chunk_bytes = heap.GetStats().chunk_bytes;
+    heap.Collect({});
+    for (int i = 0; i < 1000; ++i) {
+        Make<Cell>();
+    }
+    EXPECT_EQ(heap.GetStats().chunk_bytes, chunk_bytes);
+    EXPECT_GE(heap.GetStats().chunks, 1u);
+}
+
+TEST(HeapTest, RunsAreFreedCellByCell) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Cell* run = MakeRun<Cell>(10);
+    heap.Collect({run + 4});
+    EXPECT_EQ(heap.GetStats().objects_live, 1u);
+}
+
+TEST(HeapTest, InterpreterCollectsBetweenForms) {
+    Interpreter interpreter;
+    Eval(&interpreter, "(define keep (list 1 2 3))");
+    for (int i = 0; i < 2000; ++i) {
+        Eval(&interpreter, "(list 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20)");
+    }
+    GcStats stats = interpreter.GetGcStats();
+    EXPECT_GT(stats.collections, 0u);
+    EXPECT_LT(stats.bytes_live, stats.bytes_allocated / 2);
+    EXPECT_EQ(Eval(&interpreter, "keep"), "(1 2 3)");
+}
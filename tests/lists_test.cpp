@@ -0,0 +1,80 @@
+#include "test_util.h"
+
+namespace {
+
+// A quoted list of the numbers 0 to n - 1.
+std::string QuotedRange(size_t n) {
+    std::string text = "'(";
+    for (size_t i = 0; i < n; ++i) {
+        text += std::to_string(i) + " ";
+    }
+    text.back() = ')';
+    return text;
+}
+
+}  // namespace
+
+TEST(ListsTest, MakeListLaysOutRuns) {
+    Heap heap;
+    HeapScope scope(&heap);
+    std::vector<Object*> elements(Cell::kMaxRun + 10, Make<Number>(int64_t{1}));
+    Object* list = MakeList(ArgumentsView(elements.data(), elements.size()));
+    size_t runs = 0;
+    size_t cells = 0;
+    for (Object* rest = list; rest != nullptr; rest = DropCells(rest, As<Cell>(rest)->GetRun())) {
+        size_t run = As<Cell>(rest)->GetRun();
+        EXPECT_LE(run, Cell::kMaxRun);
+        ++runs;
+        cells += run;
+    }
+    EXPECT_EQ(runs, 2u);
+    EXPECT_EQ(cells, elements.size());
+    EXPECT_EQ(As<Cell>(DropCells(list, elements.size() - 1))->second_, nullptr);
+    EXPECT_EQ(DropCells(list, elements.size()), nullptr);
+}
+
+class ListsTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(ListsTest);
+
+TEST_P(ListsTest, IndexingLongLists) {
+    Eval("(define xs " + QuotedRange(70000) + ")");
+    EXPECT_EQ(Eval("(list-ref xs 0)"), "0");
+    EXPECT_EQ(Eval("(list-ref xs 65535)"), "65535");
+    EXPECT_EQ(Eval("(list-ref xs 69999)"), "69999");
+    EXPECT_EQ(Eval("(list-ref xs 70000)"), "RuntimeError");
+    EXPECT_EQ(Eval("(list-tail xs 69998)"), "(69998 69999)");
+    EXPECT_EQ(Eval("(list? xs)"), "#t");
+}
+
+TEST_P(ListsTest, RunsMixedWithConsedCells) {
+    Eval("(define xs (cons 'a (cons 'b '(1 2 3))))");
+    EXPECT_EQ(Eval("(list-ref xs 3)"), "2");
+    EXPECT_EQ(Eval("(list-tail xs 1)"), "(b 1 2 3)");
+    EXPECT_EQ(Eval("(list? xs)"), "#t");
+    EXPECT_EQ(Eval("(list? '(1 2 . 3))"), "#f");
+    EXPECT_EQ(Eval("(list? (cons 1 2))"), "#f");
+    EXPECT_EQ(Eval("(list-tail '(1 2 . 3) 2)"), "3");
+}
+
+TEST_P(ListsTest, CarAndCdr) {
+    EXPECT_EQ(Eval("(car '(1 2 3))"), "1");
+    EXPECT_EQ(Eval("(cdr '(1 2 3))"), "(2 3)");
+    EXPECT_EQ(Eval("(cdr '(1))"), "()");
+    EXPECT_EQ(Eval("(cdr '(1 . 2))"), "2");
+    EXPECT_EQ(Eval("(pair? '())"), "#f");
+    EXPECT_EQ(Eval("(null? (cdr '(1)))"), "#t");
+}
+
+// pair? looks at the cell, not at the data in it, which is never evaluated.
+TEST_P(ListsTest, PairPredicate) {
+    EXPECT_EQ(Eval("(pair? '(1 . 2))"), "#t");
+    EXPECT_EQ(Eval("(pair? '(1))"), "#t");
+    EXPECT_EQ(Eval("(pair? '(1 2 3))"), "#t");
+    EXPECT_EQ(Eval("(pair? (cons 1 '()))"), "#t");
+    EXPECT_EQ(Eval("(pair? '((define x 1) 2))"), "#t");
+    EXPECT_EQ(Eval("(pair? '((car '()) (undefined)))"), "#t");
+    EXPECT_EQ(Eval("(pair? 1)"), "#f");
+    EXPECT_EQ(Eval("(pair? #(1 2))"), "#f");
+    EXPECT_EQ(Eval("x"), "NameError");
+}
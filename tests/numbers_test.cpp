@@ -0,0 +1,83 @@
+#include "test_util.h"
+
+#include <sstream>
+
+class NumbersTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(NumbersTest);
+
+TEST_P(NumbersTest, Tower) {
+    EXPECT_EQ(Eval("(/ 7 2)"), "7/2");
+    EXPECT_EQ(Eval("(/ 6 3)"), "2");
+    EXPECT_EQ(Eval("(+ 1/2 1/2)"), "1");
+    EXPECT_EQ(Eval("(+ 1/2 0.5)"), "1.0");
+    EXPECT_EQ(Eval("(* 2 1.5)"), "3.0");
+    EXPECT_EQ(Eval("(- 1/3 2/3)"), "-1/3");
+    EXPECT_EQ(Eval("(abs -7/2)"), "7/2");
+    EXPECT_EQ(Eval("(/ 1 0)"), "RuntimeError");
+    EXPECT_EQ(Eval("(/ 1.0 0)"), "+inf.0");
+}
+
+TEST_P(NumbersTest, MixedComparisons) {
+    EXPECT_EQ(Eval("(= 1/2 0.5)"), "#t");
+    EXPECT_EQ(Eval("(< 1/3 0.34 1)"), "#t");
+    EXPECT_EQ(Eval("(> 100000000000000000000 1e19)"), "#t");
+    EXPECT_EQ(Eval("(= 0.0 -0.0)"), "#t");
+    EXPECT_EQ(Eval("(max 1 2.0)"), "2.0");
+    EXPECT_EQ(Eval("(min 1/2 1/3)"), "1/3");
+}
+
+TEST_P(NumbersTest, NaNIsUnordered) {
+    Eval("(define nan (/ 0.0 0.0))");
+    EXPECT_EQ(Eval("nan"), "+nan.0");
+    for (const char* op : {"=", "<", ">", "<=", ">="}) {
+        std::string name = op;
+        EXPECT_EQ(Eval("(" + name + " nan 1.0)"), "#f") << op;
+        EXPECT_EQ(Eval("(" + name + " 1 nan)"), "#f") << op;
+        EXPECT_EQ(Eval("(" + name + " nan nan)"), "#f") << op;
+        EXPECT_EQ(Eval("(" + name + " 1 1 nan)"), "#f") << op;
+        EXPECT_EQ(Eval("(" + name + " nan 1 1 1)"), "#f") << op;
+    }
+}
+
+TEST_P(NumbersTest, NaNWinsMinAndMax) {
+    Eval("(define nan (/ 0.0 0.0))");
+    EXPECT_EQ(Eval("(max 1 nan 2)"), "+nan.0");
+    EXPECT_EQ(Eval("(min nan 1)"), "+nan.0");
+    EXPECT_EQ(Eval("(max 1.0 2.0 3.0 4.0 5.0 6.0 7.0 8.0 9.0 nan)"), "+nan.0");
+    EXPECT_EQ(Eval("(min 1 2 3 4 5 6 7 8 9 nan)"), "+nan.0");
+}
+
+// Adding reals is not associative, so + has to add them in argument order.
+TEST_P(NumbersTest, RealsAreAddedLeftToRight) {
+    for (std::string numbers : {"0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9",
+                                "1e16 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0",
+                                "1/3 0.1 0.2 0.3 0.4 0.5 0.6 0.7", "1 2 3 4 0.1 0.2 0.3 0.4 0.5",
+                                "1e16 121 508 780 461 484", "0.5 1e16 3 3 3 3 3 3 1.0"}) {
+        std::istringstream in(numbers);
+        std::string first;
+        in >> first;
+        std::string nested = first;
+        for (std::string number; in >> number;) {
+            nested = "(+ " + nested + " " + number + ")";
+        }
+        EXPECT_EQ(Eval("(+ " + numbers + ")"), Eval(nested)) << numbers;
+    }
+    EXPECT_EQ(Eval("(+ 1e16 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0)"), Eval("1e16"));
+    EXPECT_EQ(Eval("(+ 1e16 121 508 780 461 484)"), Eval("10000000000002352.0"));
+}
+
+TEST_P(NumbersTest, RealLiteralsOutOfRange) {
+    EXPECT_EQ(Eval("1e400"), "+inf.0");
+    EXPECT_EQ(Eval("-1e400"), "-inf.0");
+    EXPECT_EQ(Eval("1e-400"), "0.0");
+    EXPECT_EQ(Eval("-1e-400"), "-0.0");
+    EXPECT_EQ(Eval("(/ 1 -1e-400)"), "-inf.0");
+    EXPECT_EQ(Eval("(> 4.9e-324 0)"), "#t");
+}
+
+TEST_P(NumbersTest, RealLiterals) {
+    EXPECT_EQ(Eval("1.5e3"), "1500.0");
+    EXPECT_EQ(Eval("-2.5"), "-2.5");
+    EXPECT_EQ(Eval("1E2"), "100.0");
+}
@@ -0,0 +1,65 @@
+#include "test_util.h"
+
+#include <sstream>
+
+namespace {
+
+Object* ReadOne(const std::string& source) {
+    Tokenizer tokenizer{std::string_view(source)};
+    return Read(&tokenizer);
+}
+
+// Prints value both ways and checks that they agree.
+std::string Printed(Object* value) {
+    std::string text;
+    Print(value, &text);
+    std::ostringstream out;
+    Print(value, &out);
+    EXPECT_EQ(out.str(), text);
+    return text;
+}
+
+}  // namespace
+
+TEST(PrinterTest, Atoms) {
+    EXPECT_EQ(Printed(ReadOne("42")), "42");
+    EXPECT_EQ(Printed(ReadOne("-7/2")), "-7/2");
+    EXPECT_EQ(Printed(ReadOne("2.5")), "2.5");
+    EXPECT_EQ(Printed(ReadOne("abc")), "abc");
+    EXPECT_EQ(Printed(ReadOne("#t")), "#t");
+    EXPECT_EQ(Printed(ReadOne("()")), "()");
+}
+
+TEST(PrinterTest, Compounds) {
+    EXPECT_EQ(Printed(ReadOne("(1 2 3)")), "(1 2 3)");
+    EXPECT_EQ(Printed(ReadOne("(1 2 . 3)")), "(1 2 . 3)");
+    EXPECT_EQ(Printed(ReadOne("#(1 #(2) #u8(3 4))")), "#(1 #(2) #u8(3 4))");
+    EXPECT_EQ(Printed(ReadOne("(#(1 2) #())")), "(#(1 2) #())");
+}
+
+TEST(PrinterTest, LongAndDeepStructures) {
+    std::string flat = "(";
+    for (int i = 0; i < 100000; ++i) {
+        flat += "x ";
+    }
+    flat.back() = ')';
+    EXPECT_EQ(Printed(ReadOne(flat)), flat);
+
+    std::string vectors;
+    for (int i = 0; i < 100000; ++i) {
+        vectors += "#(";
+    }
+    vectors += "1";
+    for (int i = 0; i < 100000; ++i) {
+        vectors += ")";
+    }
+    EXPECT_EQ(Printed(ReadOne(vectors)), vectors);
+}
+
+TEST(PrinterTest, RunWritesToAStream) {
+    Interpreter interpreter;
+    std::ostringstream out;
+    interpreter.Run("'(1 #(2 3) . 4)", &out);
+    EXPECT_EQ(out.str(), "(1 #(2 3) . 4)");
+    EXPECT_EQ(interpreter.Run("'(1 #(2 3) . 4)"), out.str());
+}
@@ -0,0 +1,89 @@
+#include "test_util.h"
+
+#include <sstream>
+
+namespace {
+
+std::string Nested(size_t depth, const std::string& inside = "1") {
+    return std::string(depth, '(') + inside + std::string(depth, ')');
+}
+
+std::string ReadAndPrint(const std::string& source, size_t max_depth = kNoReadDepthLimit) {
+    Tokenizer tokenizer{std::string_view(source)};
+    std::string text;
+    Print(Read(&tokenizer, max_depth), &text);
+    return text;
+}
+
+size_t ListLength(Object* list) {
+    size_t length = 0;
+    for (; Is<Cell>(list); list = As<Cell>(list)->second_) {
+        ++length;
+    }
+    return length;
+}
+
+// How many lists are nested at the front of expr, like ((1)) has two.
+size_t FrontDepth(Object* expr) {
+    size_t depth = 0;
+    for (; Is<Cell>(expr); expr = As<Cell>(expr)->first_) {
+        ++depth;
+    }
+    return depth;
+}
+
+Object* ReadOne(const std::string& source, size_t max_depth = kNoReadDepthLimit) {
+    Tokenizer tokenizer{std::string_view(source)};
+    return Read(&tokenizer, max_depth);
+}
+
+}  // namespace
+
+TEST(ReaderTest, Lists) {
+    // Nested lists print without their own brackets.
+    EXPECT_EQ(ReadAndPrint("(1 (2 3) () 4)"), "(1 2 3 () 4)");
+    Object* list = ReadOne("(1 (2 3) 4)");
+    EXPECT_EQ(ListLength(list), 3u);
+    EXPECT_EQ(ListLength(As<Cell>(As<Cell>(list)->second_)->first_), 2u);
+    EXPECT_EQ(ReadAndPrint("(1 . 2)"), "(1 . 2)");
+    EXPECT_EQ(ReadAndPrint("(1 2 . (3 4))"), "(1 2 3 4)");
+    EXPECT_EQ(ReadAndPrint("#(1 #u8(2) (3 4))"), "#(1 #u8(2) (3 4))");
+}
+
+TEST(ReaderTest, MalformedInput) {
+    for (const char* source : {"(", "(1 2", "(1))", "(. 1)", "(1 .)", "(1 . 2 3)", "#(1 . 2)",
+                               ""}) {
+        EXPECT_THROW(ReadAndPrint(source), SyntaxError) << source;
+    }
+}
+
+TEST(ReaderTest, DeepNestingNeedsNoNativeStack) {
+    EXPECT_EQ(FrontDepth(ReadOne(Nested(200000))), 200000u);
+}
+
+TEST(ReaderTest, LongFlatList) {
+    std::string source = "(";
+    for (int i = 0; i < 200000; ++i) {
+        source += std::to_string(i % 10) + " ";
+    }
+    source.back() = ')';
+    EXPECT_EQ(ReadAndPrint(source), source);
+}
+
+TEST(ReaderTest, DepthLimit) {
+    EXPECT_EQ(FrontDepth(ReadOne(Nested(10), 10)), 10u);
+    EXPECT_THROW(ReadAndPrint(Nested(11), 10), SyntaxError);
+    EXPECT_THROW(ReadAndPrint("#(" + Nested(10) + ")", 10), SyntaxError);
+    EXPECT_EQ(ReadAndPrint("(1 2 3 4 5 6 7 8 9 10 11 12)", 1), "(1 2 3 4 5 6 7 8 9 10 11 12)");
+}
+
+TEST(ReaderTest, InterpreterDepthLimit) {
+    Interpreter interpreter;
+    interpreter.SetMaxReadDepth(3);
+    EXPECT_EQ(Eval(&interpreter, "'((1 2))"), "(1 2)");
+    EXPECT_EQ(Eval(&interpreter, "'(((1 2)))"), "SyntaxError");
+    std::istringstream in("'((1 2)) '(((1 2)))");
+    std::ostringstream out;
+    EXPECT_THROW(interpreter.Run(&in, &out), SyntaxError);
+    EXPECT_EQ(out.str(), "(1 2)\n");
+}
@@ -0,0 +1,50 @@
+#include "test_util.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+TEST(StreamTest, PrintsEachFormOnItsOwnLine) {
+    Interpreter interpreter;
+    std::istringstream in("(+ 1 2) 'a\n(define x 5)\n  x '(1 2)");
+    std::ostringstream out;
+    interpreter.Run(&in, &out);
+    EXPECT_EQ(out.str(), "3\na\nx\n5\n(1 2)\n");
+}
+
+TEST(StreamTest, EmptyInputPrintsNothing) {
+    Interpreter interpreter;
+    std::istringstream in("  \n ");
+    std::ostringstream out;
+    interpreter.Run(&in, &out);
+    EXPECT_EQ(out.str(), "");
+}
+
+TEST(StreamTest, ValuesBeforeAnErrorAreWritten) {
+    Interpreter interpreter;
+    std::istringstream in("1 2 (car '()) 3");
+    std::ostringstream out;
+    EXPECT_THROW(interpreter.Run(&in, &out), RuntimeError);
+    EXPECT_EQ(out.str(), "1\n2\n");
+}
+
+TEST(StreamTest, FormsLongerThanABlockAreRead) {
+    std::string sum = "(+";
+    for (int i = 0; i < 100000; ++i) {
+        sum += " 1";
+    }
+    sum += ")";
+    Interpreter interpreter;
+    std::istringstream in(sum + " " + sum);
+    std::ostringstream out;
+    interpreter.Run(&in, &out);
+    EXPECT_EQ(out.str(), "100000\n100000\n");
+}
+
+TEST(StreamTest, UnfinishedFormIsASyntaxError) {
+    Interpreter interpreter;
+    std::istringstream in("1 (+ 1");
+    std::ostringstream out;
+    EXPECT_THROW(interpreter.Run(&in, &out), SyntaxError);
+    EXPECT_EQ(out.str(), "1\n");
+}
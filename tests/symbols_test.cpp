@@ -0,0 +1,43 @@
+#include "test_util.h"
+
+TEST(SymbolsTest, InterningIsStable) {
+    SymbolId id = Intern("some-symbol");
+    EXPECT_EQ(Intern("some-symbol"), id);
+    EXPECT_NE(Intern("Some-symbol"), id);
+    EXPECT_EQ(SymbolName(id), "some-symbol");
+    EXPECT_EQ(Intern("#t"), kTrueSymbol);
+    EXPECT_EQ(Intern("#f"), kFalseSymbol);
+    EXPECT_EQ(Intern("()"), kEmptyListSymbol);
+    EXPECT_EQ(Intern("'"), kQuoteMarkSymbol);
+}
+
+TEST(SymbolsTest, OneObjectPerSymbol) {
+    EXPECT_EQ(MakeSymbol(Intern("abc")), MakeSymbol(Intern("abc")));
+    EXPECT_EQ(MakeSymbol(kTrueSymbol), True());
+    EXPECT_EQ(MakeBool(false), False());
+    EXPECT_EQ(ToValue(nullptr), EmptyList());
+}
+
+TEST(SymbolsTest, TokensCarryIds) {
+    Tokenizer tokenizer{std::string_view("foo bar foo")};
+    SymbolId first = std::get<SymbolToken>(tokenizer.GetToken()).id;
+    tokenizer.Next();
+    tokenizer.Next();
+    EXPECT_EQ(std::get<SymbolToken>(tokenizer.GetToken()).id, first);
+    EXPECT_EQ(SymbolName(first), "foo");
+}
+
+class SymbolsEvaluationTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(SymbolsEvaluationTest);
+
+TEST_P(SymbolsEvaluationTest, QuotedSymbols) {
+    EXPECT_EQ(Eval("'hello"), "hello");
+    EXPECT_EQ(Eval("'(a b c)"), "(a b c)");
+    EXPECT_EQ(Eval("#t"), "#t");
+    EXPECT_EQ(Eval("(boolean? '#f)"), "#t");
+    EXPECT_EQ(Eval("(boolean? 'f)"), "#f");
+    Eval("(define h (make-hash-table))");
+    Eval("(hash-table-set! h 'key 1)");
+    EXPECT_EQ(Eval("(hash-table-ref h (car '(key)))"), "1");
+}
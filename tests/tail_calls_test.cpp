@@ -0,0 +1,93 @@
+#include "test_util.h"
+
+class TailCallsTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(TailCallsTest);
+
+TEST_P(TailCallsTest, LoopsRunInConstantStack) {
+    Eval("(define (count n) (if (= n 0) 'done (count (- n 1))))");
+    EXPECT_EQ(Eval("(count 1000000)"), "done");
+    Eval("(define (loop i) (cond ((= i 0) 'cond) (else (loop (- i 1)))))");
+    EXPECT_EQ(Eval("(loop 300000)"), "cond");
+    Eval("(define (down i) (when (> i 0) (down (- i 1))))");
+    Eval("(down 300000)");
+    Eval("(define (go i) (or (= i 0) (and #t (go (- i 1)))))");
+    EXPECT_EQ(Eval("(go 300000)"), "#t");
+    EXPECT_EQ(Eval("(let loop ((i 0)) (if (< i 300000) (loop (+ i 1)) i))"), "300000");
+}
+
+TEST_P(TailCallsTest, MutualRecursion) {
+    Eval("(define (even? n) (if (= n 0) #t (odd? (- n 1))))");
+    Eval("(define (odd? n) (if (= n 0) #f (even? (- n 1))))");
+    EXPECT_EQ(Eval("(even? 300001)"), "#f");
+    EXPECT_EQ(Eval("(odd? 300001)"), "#t");
+}
+
+TEST_P(TailCallsTest, LongConditionalChains) {
+    std::string chain = "(and";
+    for (int i = 0; i < 100000; ++i) {
+        chain += " 1";
+    }
+    EXPECT_EQ(Eval(chain + " 'last)"), "last");
+    chain = "(or";
+    for (int i = 0; i < 100000; ++i) {
+        chain += " #f";
+    }
+    EXPECT_EQ(Eval(chain + " 'last)"), "last");
+}
+
+TEST_P(TailCallsTest, ArityErrorsInTailPosition) {
+    Eval("(define (f x) x)");
+    Eval("(define (g) (f 1 2))");
+    EXPECT_EQ(Eval("(g)"), "RuntimeError");
+    EXPECT_EQ(Eval("(f 3)"), "3");
+}
+
+TEST_P(TailCallsTest, DeepNonTailRecursion) {
+    Eval("(define (g n) (if (= n 0) 0 (+ 1 (g (- n 1)))))");
+    EXPECT_EQ(Eval("(g 100000)"), "100000");
+    Eval("(define (sum n) (if (= n 0) 0 (+ n (sum (- n 1)))))");
+    EXPECT_EQ(Eval("(sum 200000)"), "20000100000");
+}
+
+// Resolving, folding, compiling and the tree walker go without recursion too.
+TEST_P(TailCallsTest, DeeplyNestedExpressions) {
+    const int depth = 200000;
+    std::string nested;
+    for (int i = 0; i < depth; ++i) {
+        nested += "(+ 1 ";
+    }
+    EXPECT_EQ(Eval(nested + "0" + std::string(depth, ')')), "200000");
+    Eval("(define x 0)");
+    EXPECT_EQ(Eval(nested + "x" + std::string(depth, ')')), "200000");
+    std::string conditions;
+    for (int i = 0; i < depth; ++i) {
+        conditions += "(if #t ";
+    }
+    EXPECT_EQ(Eval(conditions + "'deep" + std::string(depth, ')')), "deep");
+}
+
+// Quoted data nested as deep as the reader allows is never walked recursively.
+TEST_P(TailCallsTest, DeeplyNestedData) {
+    const int depth = 200000;
+    std::string nested;
+    for (int i = 0; i < depth; ++i) {
+        nested += "(+ 1 ";
+    }
+    nested += "0" + std::string(depth, ')');
+    EXPECT_EQ(Eval("(pair? '(" + nested + " 2))"), "#t");
+    EXPECT_EQ(Eval("(pair? (car '(" + nested + ")))"), "#t");
+    EXPECT_EQ(Eval("(null? '" + nested + ")"), "#f");
+}
+
+TEST(TailCallsTest, CollectsWithinAForm) {
+    for (EvaluationMode mode : {EvaluationMode::TREE_WALK, EvaluationMode::BYTECODE}) {
+        Interpreter interpreter;
+        interpreter.SetEvaluationMode(mode);
+        Eval(&interpreter,
+             "(define (churn i keep)"
+             "  (if (= i 0) keep (churn (- i 1) (car (cons keep (list 1 2 3))))))");
+        EXPECT_EQ(Eval(&interpreter, "(churn 200000 'kept)"), "kept");
+        EXPECT_GT(interpreter.GetGcStats().collections, 0u);
+    }
+}
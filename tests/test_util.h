@@ -0,0 +1,76 @@
+#pragma once
+
+#include "scheme.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+// The printed value of expr, or the name of the error it raises.
+inline std::string Eval(Interpreter* interpreter, const std::string& expr) {
+    try {
+        return interpreter->Run(expr);
+    } catch (const SyntaxError&) {
+        return "SyntaxError";
+    } catch (const RuntimeError&) {
+        return "RuntimeError";
+    } catch (const NameError&) {
+        return "NameError";
+    }
+}
+
+// The ways an Interpreter can be set up to evaluate, which all have to agree.
+struct Configuration {
+    EvaluationMode mode;
+    bool folding;
+    size_t cache_capacity;
+};
+
+inline void Configure(Interpreter* interpreter, const Configuration& configuration) {
+    interpreter->SetEvaluationMode(configuration.mode);
+    interpreter->SetConstantFolding(configuration.folding);
+    interpreter->SetCacheCapacity(configuration.cache_capacity);
+}
+
+inline const Configuration kConfigurations[] = {
+    {EvaluationMode::BYTECODE, false, 0},
+    {EvaluationMode::TREE_WALK, false, 0},
+    {EvaluationMode::BYTECODE, true, 0},
+    {EvaluationMode::TREE_WALK, true, 0},
+    {EvaluationMode::BYTECODE, false, 16},
+    {EvaluationMode::TREE_WALK, false, 16},
+    {EvaluationMode::BYTECODE, true, 16},
+    {EvaluationMode::TREE_WALK, true, 16},
+};
+
+inline std::string ConfigurationName(const Configuration& configuration) {
+    std::string name = configuration.mode == EvaluationMode::BYTECODE ? "Bytecode" : "TreeWalk";
+    if (configuration.folding) {
+        name += "Folding";
+    }
+    if (configuration.cache_capacity != 0) {
+        name += "Cached";
+    }
+    return name;
+}
+
+// Runs each test once per configuration; derive a fixture per suite and
+// instantiate it with INSTANTIATE_CONFIGURATIONS.
+class InterpreterTest : public ::testing::TestWithParam<Configuration> {
+protected:
+    void SetUp() override {
+        Configure(&interpreter_, GetParam());
+    }
+
+    std::string Eval(const std::string& expr) {
+        return ::Eval(&interpreter_, expr);
+    }
+
+    Interpreter interpreter_;
+};
+
+#define INSTANTIATE_CONFIGURATIONS(fixture)                                         \
+    INSTANTIATE_TEST_SUITE_P(Configurations, fixture, ::testing::ValuesIn(kConfigurations), \
+                             [](const ::testing::TestParamInfo<Configuration>& info) {   \
+                                 return ConfigurationName(info.param);                   \
+                             })
@@ -0,0 +1,90 @@
+#include "tokenizer.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+namespace {
+
+std::vector<Token> ReadAll(Tokenizer* tokenizer) {
+    std::vector<Token> tokens;
+    while (!tokenizer->IsEnd()) {
+        tokens.push_back(tokenizer->GetToken());
+        tokenizer->Next();
+    }
+    return tokens;
+}
+
+std::vector<Token> Tokenize(const std::string& text) {
+    Tokenizer tokenizer{std::string_view(text)};
+    return ReadAll(&tokenizer);
+}
+
+std::vector<Token> TokenizeStream(const std::string& text) {
+    std::istringstream in(text);
+    Tokenizer tokenizer{&in};
+    return ReadAll(&tokenizer);
+}
+
+Token Integer(int64_t value) {
+    ConstantToken token;
+    token.value = value;
+    return token;
+}
+
+}  // namespace
+
+TEST(TokenizerTest, Basic) {
+    std::vector<Token> expected = {BracketToken::OPEN, SymbolToken("foo?"), Integer(-12),
+                                   QuoteToken{},       SymbolToken("+"),    DotToken{},
+                                   BracketToken::CLOSE};
+    EXPECT_EQ(Tokenize("(foo? -12 '+ . )"), expected);
+}
+
+TEST(TokenizerTest, VectorOpeners) {
+    std::vector<Token> expected = {BracketToken::OPEN_VECTOR, Integer(1),
+                                   BracketToken::OPEN_BYTEVECTOR, BracketToken::CLOSE,
+                                   BracketToken::CLOSE};
+    EXPECT_EQ(Tokenize("#(1 #u8())"), expected);
+}
+
+TEST(TokenizerTest, LongRunsOfEveryClass) {
+    for (size_t length : {1, 15, 16, 17, 31, 32, 33, 64, 100}) {
+        std::string name(length, 'a');
+        std::string spaces(length, ' ');
+        std::string digits(std::min<size_t>(length, 18), '1');
+        std::vector<Token> expected = {SymbolToken(name), Integer(std::stoll(digits)),
+                                       SymbolToken(name)};
+        EXPECT_EQ(Tokenize(spaces + name + spaces + digits + "\n" + name + spaces), expected)
+            << length;
+    }
+}
+
+TEST(TokenizerTest, StreamMatchesBuffer) {
+    // Tokens straddle the block boundaries of the stream reader.
+    std::string text;
+    for (int i = 0; text.size() < 20000; ++i) {
+        text += "(sym" + std::to_string(i) + " " + std::to_string(i * 7919) + " 'x)   ";
+        text += std::string(i % 37, ' ');
+    }
+    EXPECT_EQ(TokenizeStream(text), Tokenize(text));
+}
+
+TEST(TokenizerTest, TokenLongerThanABlock) {
+    std::string name(10000, 'q');
+    std::vector<Token> expected = {BracketToken::OPEN, SymbolToken(name), BracketToken::CLOSE};
+    EXPECT_EQ(TokenizeStream("(" + name + ")"), expected);
+}
+
+TEST(TokenizerTest, BigIntegers) {
+    std::vector<Token> tokens = Tokenize("123456789012345678901234567890");
+    ASSERT_EQ(tokens.size(), 1u);
+    const ConstantToken& token = std::get<ConstantToken>(tokens[0]);
+    ASSERT_TRUE(token.big.has_value());
+    EXPECT_EQ(token.big->ToString(), "123456789012345678901234567890");
+}
+
+TEST(TokenizerTest, UnknownCharacterIsASyntaxError) {
+    EXPECT_THROW(Tokenize("(a @)"), SyntaxError);
+}
@@ -0,0 +1,39 @@
+#include "test_util.h"
+
+TEST(ValuesTest, SmallNumbersAreShared) {
+    Heap heap;
+    HeapScope scope(&heap);
+    EXPECT_EQ(MakeNumber(int64_t{0}), MakeNumber(int64_t{0}));
+    EXPECT_EQ(MakeNumber(int64_t{kMinCachedNumber}), MakeNumber(int64_t{kMinCachedNumber}));
+    EXPECT_EQ(MakeNumber(int64_t{kMaxCachedNumber}), MakeNumber(int64_t{kMaxCachedNumber}));
+    EXPECT_EQ(heap.GetStats().objects_live, 0u);
+    EXPECT_NE(MakeNumber(int64_t{kMaxCachedNumber + 1}), MakeNumber(int64_t{kMaxCachedNumber + 1}));
+    EXPECT_EQ(heap.GetStats().objects_live, 2u);
+}
+
+TEST(ValuesTest, TypeTags) {
+    Heap heap;
+    HeapScope scope(&heap);
+    Object* number = MakeNumber(int64_t{5});
+    Object* cell = Make<Cell>();
+    EXPECT_TRUE(Is<Number>(number));
+    EXPECT_FALSE(Is<Cell>(number));
+    EXPECT_EQ(As<Cell>(cell), cell);
+    EXPECT_EQ(As<Number>(cell), nullptr);
+    EXPECT_FALSE(Is<Number>(nullptr));
+    EXPECT_TRUE(Is<Symbol>(True()));
+}
+
+TEST(ValuesTest, PredicatesAllocateNothing) {
+    Interpreter interpreter;
+    Eval(&interpreter, "(define (loop i) (if (< i 1000) (loop (+ i 1)) (not (null? '()))))");
+    Eval(&interpreter, "(loop 0)");
+    size_t allocated = interpreter.GetGcStats().bytes_allocated;
+    EXPECT_EQ(Eval(&interpreter, "(loop 0)"), "#f");
+    // Only numbers up to kMaxCachedNumber are shared, and counting to 1000 stays
+    // below it, so only the frames allocate. A longer loop would allocate its
+    // counter too.
+    static_assert(kMaxCachedNumber >= 1000);
+    size_t per_iteration = (interpreter.GetGcStats().bytes_allocated - allocated) / 1000;
+    EXPECT_LE(per_iteration, 128u);
+}
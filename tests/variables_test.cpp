@@ -0,0 +1,117 @@
+#include "test_util.h"
+
+#include <sstream>
+
+namespace {
+
+// Whether every cell of the list reaches the cells of its run through second_.
+bool RunsAreValid(Object* list) {
+    for (Cell* cell = As<Cell>(list); cell != nullptr; cell = As<Cell>(cell->second_)) {
+        Object* next = cell;
+        for (size_t i = 1; i < cell->GetRun(); ++i) {
+            next = As<Cell>(next)->second_;
+            if (next != cell->Advance(i)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(VariablesTest, ResolvingKeepsListRuns) {
+    for (const char* source : {"(define x (+ 1 2))", "(set! x 5)", "(define (f a) a)"}) {
+        GlobalEnvironment globals;
+        std::istringstream in(source);
+        Tokenizer tokenizer{&in};
+        Object* read = Read(&tokenizer);
+        Object* resolved = Resolver::Resolve(read, &globals);
+        EXPECT_TRUE(RunsAreValid(read)) << source;
+        EXPECT_TRUE(RunsAreValid(resolved)) << source;
+    }
+}
+
+// The resolver keeps its work on an explicit stack, like the reader.
+TEST(VariablesTest, ResolvingDeepExpressionsNeedsNoNativeStack) {
+    const size_t depth = 200000;
+    std::string source = "(lambda (x) ";
+    for (size_t i = 0; i < depth; ++i) {
+        source += "(+ x ";
+    }
+    source += "x" + std::string(depth + 1, ')');
+    GlobalEnvironment globals;
+    Tokenizer tokenizer{std::string_view(source)};
+    Lambda* lambda = As<Lambda>(Resolver::Resolve(Read(&tokenizer), &globals));
+    ASSERT_NE(lambda, nullptr);
+    Object* expr = As<Cell>(lambda->GetBody())->first_;
+    for (size_t i = 0; i < depth; ++i) {
+        Cell* call = As<Cell>(expr);
+        ASSERT_NE(call, nullptr);
+        ASSERT_TRUE(Is<LocalRef>(As<Cell>(call->second_)->first_));
+        expr = As<Cell>(As<Cell>(call->second_)->second_)->first_;
+    }
+    EXPECT_TRUE(Is<LocalRef>(expr));
+
+    // Every name is looked up through all the frames around it, so the
+    // lambdas are nested less deeply.
+    const size_t lambdas = 10000;
+    source = "(define (outer a) ";
+    for (size_t i = 0; i < lambdas; ++i) {
+        source += "(lambda (b) ";
+    }
+    source += "a" + std::string(lambdas + 1, ')');
+    Tokenizer nested{std::string_view(source)};
+    Object* definition = Resolver::Resolve(Read(&nested), &globals);
+    expr = As<Cell>(As<Cell>(definition)->second_)->second_;
+    expr = As<Cell>(expr)->first_;
+    for (size_t i = 0; i < lambdas; ++i) {
+        ASSERT_TRUE(Is<Lambda>(expr));
+        expr = As<Cell>(As<Lambda>(expr)->GetBody())->first_;
+    }
+    ASSERT_TRUE(Is<Lambda>(expr));
+    LocalRef* a = As<LocalRef>(As<Cell>(As<Lambda>(expr)->GetBody())->first_);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->GetDepth(), lambdas);
+    EXPECT_EQ(a->GetSlot(), 0u);
+}
+
+class VariablesTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(VariablesTest);
+
+TEST_P(VariablesTest, Globals) {
+    EXPECT_EQ(Eval("x"), "NameError");
+    EXPECT_EQ(Eval("(set! x 1)"), "NameError");
+    EXPECT_EQ(Eval("(define x 1)"), "x");
+    EXPECT_EQ(Eval("(set! x (+ x 1))"), "2");
+    EXPECT_EQ(Eval("x"), "2");
+    EXPECT_EQ(Eval("(define car 1)"), "SyntaxError");
+    EXPECT_EQ(Eval("(define)"), "SyntaxError");
+    EXPECT_EQ(Eval("(define x 1 2)"), "SyntaxError");
+}
+
+TEST_P(VariablesTest, LambdasAndClosures) {
+    Eval("(define (make-counter) (let ((n 0)) (lambda () (set! n (+ n 1)) n)))");
+    Eval("(define c (make-counter))");
+    Eval("(define d (make-counter))");
+    EXPECT_EQ(Eval("(c)"), "1");
+    EXPECT_EQ(Eval("(c)"), "2");
+    EXPECT_EQ(Eval("(d)"), "1");
+    EXPECT_EQ(Eval("((lambda (x . rest) rest) 1 2 3)"), "(2 3)");
+    EXPECT_EQ(Eval("((lambda (x) x))"), "RuntimeError");
+    EXPECT_EQ(Eval("(lambda (x x) x)"), "SyntaxError");
+}
+
+TEST_P(VariablesTest, InternalDefinitionsAndShadowing) {
+    Eval("(define (f x) (define y (* x 2)) (define (g) (+ x y)) (g))");
+    EXPECT_EQ(Eval("(f 5)"), "15");
+    EXPECT_EQ(Eval("((lambda (car) (+ car 1)) 4)"), "5");
+    EXPECT_EQ(Eval("(let ((list (lambda args 'mine))) (list 1 2))"), "mine");
+}
+
+TEST_P(VariablesTest, Let) {
+    EXPECT_EQ(Eval("(let ((a 1) (b 2)) (+ a b))"), "3");
+    EXPECT_EQ(Eval("(let loop ((i 0) (acc 0)) (if (= i 4) acc (loop (+ i 1) (+ acc i))))"), "6");
+    EXPECT_EQ(Eval("(let ((a)) a)"), "SyntaxError");
+}
@@ -0,0 +1,45 @@
+#include "test_util.h"
+
+class VectorsTest : public InterpreterTest {};
+
+INSTANTIATE_CONFIGURATIONS(VectorsTest);
+
+TEST_P(VectorsTest, Literals) {
+    EXPECT_EQ(Eval("#(1 (2 3) #(4))"), "#(1 (2 3) #(4))");
+    EXPECT_EQ(Eval("#()"), "#()");
+    EXPECT_EQ(Eval("#u8(0 255)"), "#u8(0 255)");
+    EXPECT_EQ(Eval("#u8(256)"), "SyntaxError");
+    EXPECT_EQ(Eval("#(1 . 2)"), "SyntaxError");
+    EXPECT_EQ(Eval("(vector? #(1))"), "#t");
+    EXPECT_EQ(Eval("(bytevector? #u8(1))"), "#t");
+}
+
+TEST_P(VectorsTest, Access) {
+    Eval("(define v (vector 1 2 3))");
+    EXPECT_EQ(Eval("(vector-length v)"), "3");
+    EXPECT_EQ(Eval("(vector-ref v 2)"), "3");
+    EXPECT_EQ(Eval("(vector-ref v 3)"), "RuntimeError");
+    EXPECT_EQ(Eval("(vector-ref v -1)"), "RuntimeError");
+    EXPECT_EQ(Eval("(vector-set! v 0 'a)"), "#(a 2 3)");
+    EXPECT_EQ(Eval("(vector-fill! v 7)"), "#(7 7 7)");
+    EXPECT_EQ(Eval("(make-vector 2 'x)"), "#(x x)");
+    EXPECT_EQ(Eval("(vector-ref #(1 2) 1)"), "2");
+}
+
+TEST_P(VectorsTest, Bytevectors) {
+    Eval("(define b (make-bytevector 3 9))");
+    EXPECT_EQ(Eval("b"), "#u8(9 9 9)");
+    EXPECT_EQ(Eval("(bytevector-u8-set! b 1 200)"), "#u8(9 200 9)");
+    EXPECT_EQ(Eval("(bytevector-u8-set! b 1 256)"), "RuntimeError");
+    EXPECT_EQ(Eval("(bytevector-u8-ref b 1)"), "200");
+    EXPECT_EQ(Eval("(bytevector-length (bytevector 1 2))"), "2");
+}
+
+TEST_P(VectorsTest, LiteralsAreImmutable) {
+    Eval("(define v #(0 0))");
+    EXPECT_EQ(Eval("(vector-set! v 0 5)"), "RuntimeError");
+    EXPECT_EQ(Eval("(vector-fill! v 5)"), "RuntimeError");
+    EXPECT_EQ(Eval("(vector-set! (car '(#(1))) 0 5)"), "RuntimeError");
+    EXPECT_EQ(Eval("(bytevector-u8-set! #u8(1 2) 0 5)"), "RuntimeError");
+    EXPECT_EQ(Eval("v"), "#(0 0)");
+}
@@ -0,0 +1,37 @@
+#include "scheme.h"
+
+#include <fstream>
+#include <iostream>
+
+// Batch driver: evaluates every top-level form of the given files (or of the
+// standard input when there are none) and prints one value per line.
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+    Interpreter interpreter;
+    try {
+        if (argc < 2) {
+            interpreter.Run(&std::cin, &std::cout);
+        }
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream file(argv[i]);
+            if (!file) {
+                std::cerr << argv[i] << ": cannot open file\n";
+                return 1;
+            }
+            interpreter.Run(&file, &std::cout);
+        }
+    } catch (const SyntaxError&) {
+        std::cout.flush();
+        std::cerr << "syntax error\n";
+        return 1;
+    } catch (const RuntimeError&) {
+        std::cout.flush();
+        std::cerr << "runtime error\n";
+        return 1;
+    } catch (const NameError&) {
+        std::cout.flush();
+        std::cerr << "name error\n";
+        return 1;
+    }
+    return 0;
+}